@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2010-2022 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_relu6_s8.c
+ * Description:  Basic s8 version of ReLU6
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M and Cortex-A (NEON) cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Acti
+ * @{
+ */
+
+/*
+ *  Basic ReLU6 function, clamping to [0, 6] 16 elements at a time when built with ARM_MATH_NEON.
+ *
+ *  Refer to header file for details.
+ *
+ */
+
+void (arm_relu6_s8)(q7_t *data, uint16_t size)
+{
+    uint16_t i = 0;
+
+#if defined(ARM_MATH_NEON)
+    const int8x16_t zero = vdupq_n_s8(0);
+    const int8x16_t six = vdupq_n_s8(6);
+
+    for (; i + 16 <= size; i += 16)
+    {
+        vst1q_s8(data + i, vminq_s8(vmaxq_s8(vld1q_s8(data + i), zero), six));
+    }
+#endif
+
+    for (; i < size; i++)
+    {
+        int32_t ip = data[i];
+
+        ip = MAX(ip, 0);
+        data[i] = MIN(ip, 6);
+    }
+}
+
+/**
+ * @} end of Acti group
+ */
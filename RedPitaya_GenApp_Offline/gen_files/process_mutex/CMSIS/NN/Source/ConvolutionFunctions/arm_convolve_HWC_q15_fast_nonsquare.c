@@ -81,7 +81,7 @@
  *
  */
 
-arm_status arm_convolve_HWC_q15_fast_nonsquare(const q15_t *Im_in,
+arm_status (arm_convolve_HWC_q15_fast_nonsquare)(const q15_t *Im_in,
                                                const uint16_t dim_im_in_x,
                                                const uint16_t dim_im_in_y,
                                                const uint16_t ch_im_in,
@@ -103,7 +103,7 @@ arm_status arm_convolve_HWC_q15_fast_nonsquare(const q15_t *Im_in,
                                                q7_t *bufferB)
 {
     (void)bufferB;
-#if defined(ARM_MATH_DSP) && !defined(ARM_MATH_MVEI)
+#if defined(ARM_MATH_NEON) || (defined(ARM_MATH_DSP) && !defined(ARM_MATH_MVEI))
     int16_t i_out_y, i_out_x, i_ker_y, i_ker_x;
 
     q15_t *pBuffer = bufferA;
@@ -116,7 +116,7 @@ arm_status arm_convolve_HWC_q15_fast_nonsquare(const q15_t *Im_in,
         return ARM_MATH_SIZE_MISMATCH;
     }
 
-    /* Run the following code for Cortex-M4 and Cortex-M7 */
+    /* Run the following code for Cortex-M4 and Cortex-M7, and Cortex-A with NEON */
 
     /* This part implements the im2col function */
     for (i_out_y = 0; i_out_y < dim_im_out_y; i_out_y++)
@@ -171,6 +171,14 @@ arm_status arm_convolve_HWC_q15_fast_nonsquare(const q15_t *Im_in,
                     q31_t sum3 = ((q31_t)bias[i + 1] << bias_shift) + NN_ROUND(out_shift);
                     q31_t sum4 = ((q31_t)bias[i + 1] << bias_shift) + NN_ROUND(out_shift);
 
+#if defined(ARM_MATH_NEON)
+                    const int32_t colLen = ch_im_in * dim_kernel_y * dim_kernel_x;
+                    sum = arm_nn_dot_q15_neon(pA, pB, colLen, sum);
+                    sum2 = arm_nn_dot_q15_neon(pA, pB2, colLen, sum2);
+                    sum3 = arm_nn_dot_q15_neon(pA2, pB, colLen, sum3);
+                    sum4 = arm_nn_dot_q15_neon(pA2, pB2, colLen, sum4);
+                    pA += colLen;
+#else
                     uint16_t colCnt = ch_im_in * dim_kernel_y * dim_kernel_x >> 1;
                     /* accumulate over the vector */
                     while (colCnt)
@@ -201,6 +209,7 @@ arm_status arm_convolve_HWC_q15_fast_nonsquare(const q15_t *Im_in,
                         sum4 += inA2 * inB2;
                         colCnt--;
                     } /* while over colCnt */
+#endif
                     *pOut++ = (q15_t)__SSAT(sum >> out_shift, 16);
                     *pOut++ = (q15_t)__SSAT(sum3 >> out_shift, 16);
                     *pOut2++ = (q15_t)__SSAT(sum2 >> out_shift, 16);
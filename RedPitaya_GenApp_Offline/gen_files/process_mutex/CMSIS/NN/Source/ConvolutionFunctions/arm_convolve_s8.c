@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2010-2022 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_convolve_s8.c
+ * Description:  s8 version of convolution using symmetric quantization.
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M and Cortex-A (NEON) cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup NNConv
+ * @{
+ */
+
+/*
+ * Basic s8 convolution function.
+ *
+ * Each output pixel gathers its receptive field into ctx->buf (im2col), padded
+ * positions holding -input_offset so they contribute nothing once the offset is
+ * added back. The accumulation is then
+ *     dot(col, filter) + input_offset * sum(filter) + bias
+ * followed by per-channel requantization, the output offset and the activation clamp.
+ *
+ * Refer header file for details.
+ *
+ */
+
+arm_status (arm_convolve_s8)(const cmsis_nn_context *ctx,
+                           const cmsis_nn_conv_params *conv_params,
+                           const cmsis_nn_per_channel_quant_params *quant_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *input_data,
+                           const cmsis_nn_dims *filter_dims,
+                           const q7_t *filter_data,
+                           const cmsis_nn_dims *bias_dims,
+                           const int32_t *bias_data,
+                           const cmsis_nn_dims *output_dims,
+                           q7_t *output_data)
+{
+    (void)bias_dims;
+
+    if (ctx->buf == NULL && arm_convolve_s8_get_buffer_size(input_dims, filter_dims) > 0)
+    {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+    q7_t *col_buffer = (q7_t *)ctx->buf;
+
+    const int32_t input_batches = input_dims->n;
+    const int32_t input_x = input_dims->w;
+    const int32_t input_y = input_dims->h;
+    const int32_t input_ch = input_dims->c;
+    const int32_t kernel_x = filter_dims->w;
+    const int32_t kernel_y = filter_dims->h;
+    const int32_t output_x = output_dims->w;
+    const int32_t output_y = output_dims->h;
+    const int32_t output_ch = output_dims->c;
+
+    const int32_t pad_x = conv_params->padding.w;
+    const int32_t pad_y = conv_params->padding.h;
+    const int32_t stride_x = conv_params->stride.w;
+    const int32_t stride_y = conv_params->stride.h;
+    const int32_t dilation_x = conv_params->dilation.w > 0 ? conv_params->dilation.w : 1;
+    const int32_t dilation_y = conv_params->dilation.h > 0 ? conv_params->dilation.h : 1;
+
+    const int32_t input_offset = conv_params->input_offset;
+    const int32_t out_offset = conv_params->output_offset;
+    const int32_t out_activation_min = conv_params->activation.min;
+    const int32_t out_activation_max = conv_params->activation.max;
+    const int32_t *output_mult = quant_params->multiplier;
+    const int32_t *output_shift = quant_params->shift;
+
+    const int32_t col_len = input_ch * kernel_y * kernel_x;
+
+    for (int32_t i_batch = 0; i_batch < input_batches; i_batch++)
+    {
+        for (int32_t i_out_y = 0; i_out_y < output_y; i_out_y++)
+        {
+            for (int32_t i_out_x = 0; i_out_x < output_x; i_out_x++)
+            {
+                /* im2col */
+                q7_t *pCol = col_buffer;
+                for (int32_t i_ker_y = 0; i_ker_y < kernel_y; i_ker_y++)
+                {
+                    const int32_t k_y = i_out_y * stride_y - pad_y + i_ker_y * dilation_y;
+                    for (int32_t i_ker_x = 0; i_ker_x < kernel_x; i_ker_x++)
+                    {
+                        const int32_t k_x = i_out_x * stride_x - pad_x + i_ker_x * dilation_x;
+                        if (k_y < 0 || k_y >= input_y || k_x < 0 || k_x >= input_x)
+                        {
+                            memset(pCol, (q7_t)(-input_offset), input_ch);
+                        }
+                        else
+                        {
+                            memcpy(pCol, input_data + (k_y * input_x + k_x) * input_ch, input_ch);
+                        }
+                        pCol += input_ch;
+                    }
+                }
+
+                const q7_t *pFilter = filter_data;
+                for (int32_t i_out_ch = 0; i_out_ch < output_ch; i_out_ch++)
+                {
+                    int32_t sum = arm_nn_dot_s8(col_buffer, pFilter, col_len);
+                    sum += input_offset * arm_nn_sum_s8(pFilter, col_len);
+                    if (bias_data)
+                    {
+                        sum += bias_data[i_out_ch];
+                    }
+                    sum = arm_nn_requantize(sum, output_mult[i_out_ch], output_shift[i_out_ch]);
+                    sum += out_offset;
+                    sum = MAX(sum, out_activation_min);
+                    sum = MIN(sum, out_activation_max);
+                    *output_data++ = (q7_t)sum;
+
+                    pFilter += col_len;
+                }
+            }
+        }
+        input_data += input_x * input_y * input_ch;
+    }
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+int32_t arm_convolve_s8_get_buffer_size(const cmsis_nn_dims *input_dims, const cmsis_nn_dims *filter_dims)
+{
+    return input_dims->c * filter_dims->w * filter_dims->h * (int32_t)sizeof(q7_t);
+}
+
+/**
+ * @} end of NNConv group
+ */
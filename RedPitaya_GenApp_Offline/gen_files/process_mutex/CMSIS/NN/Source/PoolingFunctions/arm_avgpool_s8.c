@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2010-2022 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_avgpool_s8.c
+ * Description:  Pooling function implementations
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M and Cortex-A (NEON) cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Pooling
+ * @{
+ */
+
+/*
+ * s8 average pooling function. Window sums are accumulated 8 channels at a
+ * time in 32-bit lanes when built with ARM_MATH_NEON; the rounding division
+ * (half away from zero) is the same for both paths.
+ *
+ * Refer header file for details.
+ *
+ */
+
+static q7_t arm_avgpool_s8_output(int32_t sum, int32_t count, int32_t act_min, int32_t act_max)
+{
+    sum = sum > 0 ? (sum + count / 2) / count : (sum - count / 2) / count;
+    sum = MAX(sum, act_min);
+    sum = MIN(sum, act_max);
+    return (q7_t)sum;
+}
+
+arm_status (arm_avgpool_s8)(const cmsis_nn_context *ctx,
+                          const cmsis_nn_pool_params *pool_params,
+                          const cmsis_nn_dims *input_dims,
+                          const q7_t *src,
+                          const cmsis_nn_dims *filter_dims,
+                          const cmsis_nn_dims *output_dims,
+                          q7_t *dst)
+{
+    (void)ctx;
+
+    const int32_t input_y = input_dims->h;
+    const int32_t input_x = input_dims->w;
+    const int32_t output_y = output_dims->h;
+    const int32_t output_x = output_dims->w;
+    const int32_t stride_y = pool_params->stride.h;
+    const int32_t stride_x = pool_params->stride.w;
+    const int32_t kernel_y = filter_dims->h;
+    const int32_t kernel_x = filter_dims->w;
+    const int32_t pad_y = pool_params->padding.h;
+    const int32_t pad_x = pool_params->padding.w;
+    const int32_t act_min = pool_params->activation.min;
+    const int32_t act_max = pool_params->activation.max;
+    const int32_t ch_src = input_dims->c;
+
+    for (int32_t i_y = 0; i_y < output_y; i_y++)
+    {
+        for (int32_t i_x = 0; i_x < output_x; i_x++)
+        {
+            const int32_t k_y_start = MAX(0, i_y * stride_y - pad_y);
+            const int32_t k_y_end = MIN(i_y * stride_y - pad_y + kernel_y, input_y);
+            const int32_t k_x_start = MAX(0, i_x * stride_x - pad_x);
+            const int32_t k_x_end = MIN(i_x * stride_x - pad_x + kernel_x, input_x);
+            const int32_t count = (k_y_end - k_y_start) * (k_x_end - k_x_start);
+            int32_t i_ch_in = 0;
+
+            if (count == 0)
+            {
+                return ARM_MATH_ARGUMENT_ERROR;
+            }
+
+#if defined(ARM_MATH_NEON)
+            for (; i_ch_in + 8 <= ch_src; i_ch_in += 8)
+            {
+                int32x4_t sum_lo = vdupq_n_s32(0);
+                int32x4_t sum_hi = vdupq_n_s32(0);
+                for (int32_t k_y = k_y_start; k_y < k_y_end; k_y++)
+                {
+                    for (int32_t k_x = k_x_start; k_x < k_x_end; k_x++)
+                    {
+                        int16x8_t in = vmovl_s8(vld1_s8(src + ch_src * (k_x + k_y * input_x) + i_ch_in));
+                        sum_lo = vaddw_s16(sum_lo, vget_low_s16(in));
+                        sum_hi = vaddw_s16(sum_hi, vget_high_s16(in));
+                    }
+                }
+                int32_t sums[8];
+                vst1q_s32(sums, sum_lo);
+                vst1q_s32(sums + 4, sum_hi);
+                for (int32_t i = 0; i < 8; i++)
+                {
+                    dst[i_ch_in + ch_src * (i_x + i_y * output_x) + i] = arm_avgpool_s8_output(sums[i], count, act_min, act_max);
+                }
+            }
+#endif
+
+            for (; i_ch_in < ch_src; i_ch_in++)
+            {
+                int32_t sum = 0;
+                for (int32_t k_y = k_y_start; k_y < k_y_end; k_y++)
+                {
+                    for (int32_t k_x = k_x_start; k_x < k_x_end; k_x++)
+                    {
+                        sum += src[i_ch_in + ch_src * (k_x + k_y * input_x)];
+                    }
+                }
+                dst[i_ch_in + ch_src * (i_x + i_y * output_x)] = arm_avgpool_s8_output(sum, count, act_min, act_max);
+            }
+        }
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+int32_t arm_avgpool_s8_get_buffer_size(const int dim_dst_width, const int ch_src)
+{
+    (void)dim_dst_width;
+    (void)ch_src;
+    return 0;
+}
+
+/**
+ * @} end of Pooling group
+ */
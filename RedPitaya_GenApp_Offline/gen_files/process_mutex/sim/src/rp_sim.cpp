@@ -0,0 +1,522 @@
+/*rp_sim.cpp*/
+
+#include "rp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr double ADC_CLOCK_HZ = 125e6;
+    constexpr uint32_t AXI_REGION_START = 0x1000000;
+    constexpr uint32_t AXI_REGION_SIZE = 0x200000;
+    constexpr size_t NOISE_PATTERN_SAMPLES = 4096;
+    constexpr int PHASE_TABLE_BITS = 16;
+    constexpr size_t DAC_CAPTURE_MAX = 1u << 24;
+
+    struct sim_config_t
+    {
+        std::string waveform = "sine";
+        std::string file;
+        double freq_hz = 1000.0;
+        double amplitude = 0.5;
+        double clock_scale = 1.0;
+        double file_scale = 0.0;
+        double trigger_ms = 0.0;
+        std::string dac_capture;
+    };
+
+    struct sim_channel_t
+    {
+        std::mutex mtx;
+
+        uint32_t decimation = 1;
+        uint32_t buffer_samples = 0;
+        bool axi_enabled = false;
+        bool running = false;
+
+        std::vector<int16_t> ring;
+        std::vector<int16_t> pattern;
+        bool periodic = false;
+        uint64_t phase_step = 0;
+        uint64_t phase_offset = 0;
+        uint64_t written = 0;
+
+        std::chrono::steady_clock::time_point start_time;
+        bool triggered = false;
+        uint32_t trigger_pos = 0;
+
+        std::vector<float> dac_capture;
+        uint64_t dac_dropped = 0;
+    };
+
+    sim_config_t config;
+    sim_channel_t channels[2];
+
+    double env_double(const char *name, double fallback)
+    {
+        const char *value = std::getenv(name);
+        return value ? std::strtod(value, nullptr) : fallback;
+    }
+
+    std::string env_string(const char *name, const std::string &fallback)
+    {
+        const char *value = std::getenv(name);
+        return value ? std::string(value) : fallback;
+    }
+
+    int16_t to_adc(double volts)
+    {
+        double code = std::round(volts * 8192.0);
+        if (code > 8191.0)
+            code = 8191.0;
+        if (code < -8192.0)
+            code = -8192.0;
+        return static_cast<int16_t>(code);
+    }
+
+    /*
+     * One value per comma/whitespace separated field; lines starting with '#' (gap markers) are skipped.
+     * Values are multiplied by RP_SIM_FILE_SCALE to get ADC codes. Without it, a file with any fractional
+     * value is taken as volts / normalised float samples (x8192, as a float model's data_chX.csv), and a
+     * file of integers as raw ADC codes.
+     */
+    bool load_file_pattern(std::vector<int16_t> &pattern)
+    {
+        std::ifstream in(config.file);
+        if (!in)
+        {
+            std::cerr << "[rp_sim] Cannot open RP_SIM_FILE: " << config.file << std::endl;
+            return false;
+        }
+
+        std::vector<double> values;
+        bool fractional = false;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            const char *cursor = line.c_str();
+            while (*cursor)
+            {
+                char *end = nullptr;
+                double value = std::strtod(cursor, &end);
+                if (end == cursor)
+                {
+                    ++cursor;
+                    continue;
+                }
+                fractional = fractional || std::any_of(cursor, static_cast<const char *>(end), [](char c) { return c == '.' || c == 'e' || c == 'E'; });
+                values.push_back(value);
+                cursor = end;
+            }
+        }
+
+        double scale = config.file_scale > 0.0 ? config.file_scale : (fractional ? 8192.0 : 1.0);
+        pattern.reserve(values.size());
+        for (double value : values)
+            pattern.push_back(to_adc(value * scale / 8192.0));
+
+        std::cout << "[rp_sim] Replaying " << pattern.size() << " samples from " << config.file
+                  << " (x" << scale << " to ADC codes)" << std::endl;
+        return !pattern.empty();
+    }
+
+    /*
+     * Periodic waveforms are one period sampled into a 2^PHASE_TABLE_BITS table, read with a 64-bit phase
+     * accumulator (sample i is at phase_offset + i * phase_step), so the frequency is exact and the
+     * waveform has no discontinuity however the period relates to the sample rate.
+     */
+    void build_pattern(sim_channel_t &ch, rp_channel_t id)
+    {
+        ch.pattern.clear();
+        ch.periodic = false;
+
+        if (config.waveform == "file")
+        {
+            if (load_file_pattern(ch.pattern))
+                return;
+            std::cerr << "[rp_sim] Falling back to sine waveform." << std::endl;
+        }
+
+        if (config.waveform == "noise")
+        {
+            std::mt19937 rng(1234u + static_cast<unsigned>(id));
+            std::normal_distribution<double> noise(0.0, config.amplitude / 3.0);
+            ch.pattern.resize(NOISE_PATTERN_SAMPLES);
+            for (int16_t &sample : ch.pattern)
+                sample = to_adc(noise(rng));
+            return;
+        }
+
+        double sample_rate = ADC_CLOCK_HZ / ch.decimation;
+        double cycles_per_sample = config.freq_hz > 0.0 ? config.freq_hz / sample_rate : 1.0 / sample_rate;
+        if (cycles_per_sample > 0.5)
+            cycles_per_sample = 0.5;
+
+        ch.periodic = true;
+        ch.phase_step = static_cast<uint64_t>(std::ldexp(cycles_per_sample, 64));
+        ch.phase_offset = (id == RP_CH_2) ? 1ULL << 62 : 0;
+
+        const size_t length = size_t(1) << PHASE_TABLE_BITS;
+        ch.pattern.resize(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            double phase = static_cast<double>(i) / length;
+            double volts = 0.0;
+
+            if (config.waveform == "square")
+                volts = phase < 0.5 ? config.amplitude : -config.amplitude;
+            else if (config.waveform == "triangle")
+                volts = config.amplitude * (phase < 0.5 ? 4.0 * phase - 1.0 : 3.0 - 4.0 * phase);
+            else
+                volts = config.amplitude * std::sin(2.0 * M_PI * phase);
+
+            ch.pattern[i] = to_adc(volts);
+        }
+    }
+
+    /* Writes every sample the emulated DMA would have produced since the last call. */
+    void advance(sim_channel_t &ch)
+    {
+        if (!ch.running || !ch.axi_enabled || ch.ring.empty() || ch.pattern.empty())
+            return;
+
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - ch.start_time).count();
+        uint64_t target = static_cast<uint64_t>(elapsed * (ADC_CLOCK_HZ / ch.decimation) * config.clock_scale);
+        if (target <= ch.written)
+            return;
+
+        uint64_t first = ch.written;
+        if (target - first > ch.buffer_samples)
+            first = target - ch.buffer_samples;
+
+        if (ch.periodic)
+        {
+            for (uint64_t i = first; i < target; ++i)
+                ch.ring[i % ch.buffer_samples] = ch.pattern[(ch.phase_offset + i * ch.phase_step) >> (64 - PHASE_TABLE_BITS)];
+        }
+        else
+        {
+            size_t n = ch.pattern.size();
+            for (uint64_t i = first; i < target; ++i)
+                ch.ring[i % ch.buffer_samples] = ch.pattern[i % n];
+        }
+
+        ch.written = target;
+    }
+
+    void dump_dac_capture()
+    {
+        if (config.dac_capture.empty())
+            return;
+
+        for (int i = 0; i < 2; ++i)
+        {
+            sim_channel_t &ch = channels[i];
+            std::lock_guard<std::mutex> lock(ch.mtx);
+            if (ch.dac_capture.empty())
+                continue;
+
+            std::string path = config.dac_capture + "_ch" + std::to_string(i + 1) + ".csv";
+            FILE *file = fopen(path.c_str(), "w");
+            if (!file)
+            {
+                std::cerr << "[rp_sim] Cannot write DAC capture: " << path << std::endl;
+                continue;
+            }
+            for (float v : ch.dac_capture)
+                fprintf(file, "%.6f\n", v);
+            fclose(file);
+
+            std::cout << "[rp_sim] DAC CH" << i + 1 << ": " << ch.dac_capture.size() << " values written to " << path;
+            if (ch.dac_dropped)
+                std::cout << " (" << ch.dac_dropped << " dropped, capture full)";
+            std::cout << std::endl;
+            ch.dac_capture.clear();
+        }
+    }
+
+    sim_channel_t *get_channel(int channel)
+    {
+        if (channel < 0 || channel > 1)
+            return nullptr;
+        return &channels[channel];
+    }
+}
+
+int rp_Init(void)
+{
+    config.waveform = env_string("RP_SIM_WAVEFORM", config.waveform);
+    config.file = env_string("RP_SIM_FILE", config.file);
+    config.freq_hz = env_double("RP_SIM_FREQ_HZ", config.freq_hz);
+    config.amplitude = env_double("RP_SIM_AMPLITUDE", config.amplitude);
+    config.clock_scale = env_double("RP_SIM_CLOCK_SCALE", config.clock_scale);
+    config.file_scale = env_double("RP_SIM_FILE_SCALE", config.file_scale);
+    config.trigger_ms = env_double("RP_SIM_TRIGGER_MS", config.trigger_ms);
+    config.dac_capture = env_string("RP_SIM_DAC_CAPTURE", config.dac_capture);
+
+    if (config.clock_scale <= 0.0)
+        config.clock_scale = 1.0;
+
+    std::atexit(dump_dac_capture);
+
+    std::cout << "[rp_sim] Simulated Red Pitaya backend: waveform=" << config.waveform
+              << " clock_scale=" << config.clock_scale << std::endl;
+    return RP_OK;
+}
+
+int rp_Release(void)
+{
+    dump_dac_capture();
+    return RP_OK;
+}
+
+int rp_AcqReset(void)
+{
+    for (sim_channel_t &ch : channels)
+    {
+        std::lock_guard<std::mutex> lock(ch.mtx);
+        ch.running = false;
+        ch.triggered = false;
+        ch.written = 0;
+    }
+    return RP_OK;
+}
+
+int rp_AcqSetSplitTrigger(bool)
+{
+    return RP_OK;
+}
+
+int rp_AcqSetSplitTriggerPass(bool)
+{
+    return RP_OK;
+}
+
+int rp_AcqGetSamplingRateHz(float *sampling_rate)
+{
+    if (!sampling_rate)
+        return RP_EUF;
+    *sampling_rate = static_cast<float>(ADC_CLOCK_HZ / channels[0].decimation);
+    return RP_OK;
+}
+
+int rp_AcqSetTriggerLevel(rp_channel_trigger_t, float)
+{
+    return RP_OK;
+}
+
+int rp_AcqSetTriggerSrcCh(rp_channel_t channel, rp_acq_trig_src_t)
+{
+    return get_channel(channel) ? RP_OK : RP_EOOR;
+}
+
+int rp_AcqGetTriggerStateCh(rp_channel_t channel, rp_acq_trig_state_t *state)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch || !state)
+        return RP_EOOR;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    advance(*ch);
+
+    /* The edge is reported on the first poll after RP_SIM_TRIGGER_MS so the reader starts in sync with the ring. */
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - ch->start_time).count();
+    if (ch->running && !ch->triggered && ch->buffer_samples && elapsed_ms >= config.trigger_ms)
+    {
+        ch->triggered = true;
+        ch->trigger_pos = static_cast<uint32_t>(ch->written % ch->buffer_samples);
+    }
+
+    *state = ch->triggered ? RP_TRIG_STATE_TRIGGERED : RP_TRIG_STATE_WAITING;
+    return RP_OK;
+}
+
+int rp_AcqStartCh(rp_channel_t channel)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch)
+        return RP_EOOR;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    build_pattern(*ch, channel);
+    ch->written = 0;
+    ch->triggered = false;
+    ch->start_time = std::chrono::steady_clock::now();
+    ch->running = true;
+    return RP_OK;
+}
+
+int rp_AcqStopCh(rp_channel_t channel)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch)
+        return RP_EOOR;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    advance(*ch);
+    ch->running = false;
+    return RP_OK;
+}
+
+int rp_AcqAxiGetMemoryRegion(uint32_t *start, uint32_t *size)
+{
+    if (!start || !size)
+        return RP_EUF;
+    *start = AXI_REGION_START;
+    *size = AXI_REGION_SIZE;
+    return RP_OK;
+}
+
+int rp_AcqAxiSetDecimationFactorCh(rp_channel_t channel, uint32_t decimation)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch || decimation == 0)
+        return RP_EOOR;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    ch->decimation = decimation;
+    return RP_OK;
+}
+
+int rp_AcqAxiSetTriggerDelay(rp_channel_t channel, int32_t)
+{
+    return get_channel(channel) ? RP_OK : RP_EOOR;
+}
+
+int rp_AcqAxiSetBufferSamples(rp_channel_t channel, uint32_t, uint32_t samples)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch || samples == 0)
+        return RP_EOOR;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    ch->buffer_samples = samples;
+    ch->ring.assign(samples, 0);
+    return RP_OK;
+}
+
+int rp_AcqAxiEnable(rp_channel_t channel, bool enable)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch)
+        return RP_EOOR;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    ch->axi_enabled = enable;
+    return RP_OK;
+}
+
+int rp_AcqAxiGetWritePointer(rp_channel_t channel, uint32_t *pos)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch || !pos)
+        return RP_EOOR;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    if (ch->buffer_samples == 0)
+        return RP_EOMD;
+    advance(*ch);
+    *pos = static_cast<uint32_t>(ch->written % ch->buffer_samples);
+    return RP_OK;
+}
+
+int rp_AcqAxiGetWritePointerAtTrig(rp_channel_t channel, uint32_t *pos)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch || !pos)
+        return RP_EOOR;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    *pos = ch->trigger_pos;
+    return RP_OK;
+}
+
+int rp_AcqAxiGetDataRaw(rp_channel_t channel, uint32_t pos, uint32_t *size, int16_t *buffer)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch || !size || !buffer)
+        return RP_EOOR;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    if (ch->buffer_samples == 0 || pos >= ch->buffer_samples || *size > ch->buffer_samples)
+        return RP_EOOR;
+
+    advance(*ch);
+
+    uint32_t first = std::min(*size, ch->buffer_samples - pos);
+    std::memcpy(buffer, &ch->ring[pos], first * sizeof(int16_t));
+    if (first < *size)
+        std::memcpy(buffer + first, &ch->ring[0], (*size - first) * sizeof(int16_t));
+    return RP_OK;
+}
+
+int rp_GenReset(void)
+{
+    for (sim_channel_t &ch : channels)
+    {
+        std::lock_guard<std::mutex> lock(ch.mtx);
+        ch.dac_capture.clear();
+        ch.dac_dropped = 0;
+    }
+    return RP_OK;
+}
+
+int rp_GenWaveform(rp_channel_t channel, rp_waveform_t)
+{
+    return get_channel(channel) ? RP_OK : RP_EOOR;
+}
+
+int rp_GenOutEnable(rp_channel_t channel)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch)
+        return RP_EOOR;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    if (!config.dac_capture.empty())
+        ch->dac_capture.reserve(1u << 20);
+    return RP_OK;
+}
+
+int rp_GenTriggerOnly(rp_channel_t channel)
+{
+    return get_channel(channel) ? RP_OK : RP_EOOR;
+}
+
+int rp_GenAmp(rp_channel_t channel, float amplitude)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch)
+        return RP_EOOR;
+    if (config.dac_capture.empty())
+        return RP_OK;
+
+    std::lock_guard<std::mutex> lock(ch->mtx);
+    if (ch->dac_capture.size() < DAC_CAPTURE_MAX)
+        ch->dac_capture.push_back(amplitude);
+    else
+        ch->dac_dropped++;
+    return RP_OK;
+}
+
+const int16_t *rp_SimAxiGetBuffer(rp_channel_t channel)
+{
+    sim_channel_t *ch = get_channel(channel);
+    if (!ch || ch->ring.empty())
+        return nullptr;
+    return ch->ring.data();
+}
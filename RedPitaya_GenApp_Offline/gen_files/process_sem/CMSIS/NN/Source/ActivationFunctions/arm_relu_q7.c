@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2010-2022 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_relu_q7.c
+ * Description:  Q7 version of ReLU
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M and Cortex-A (NEON) cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+/* Built once as its own object; model.c #includes this file and skips it with -DARM_NN_KERNELS_EXTERNAL */
+#ifndef ARM_NN_KERNELS_EXTERNAL
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Acti
+ * @{
+ */
+
+/**
+ * @brief Q7 RELU function
+ * @param[in,out]   data        pointer to input
+ * @param[in]       size        number of elements
+ *
+ * @details
+ *
+ * VMAX against zero, 16 elements at a time, when built with ARM_MATH_NEON.
+ *
+ */
+
+void (arm_relu_q7)(q7_t *data, uint16_t size)
+{
+    uint16_t i = 0;
+
+#if defined(ARM_MATH_NEON)
+    const int8x16_t zero = vdupq_n_s8(0);
+
+    for (; i + 16 <= size; i += 16)
+    {
+        vst1q_s8(data + i, vmaxq_s8(vld1q_s8(data + i), zero));
+    }
+#endif
+
+    for (; i < size; i++)
+    {
+        if (data[i] < 0)
+            data[i] = 0;
+    }
+}
+
+/**
+ * @} end of Acti group
+ */
+
+#endif /* ARM_NN_KERNELS_EXTERNAL */
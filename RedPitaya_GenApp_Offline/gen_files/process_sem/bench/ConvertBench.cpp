@@ -0,0 +1,154 @@
+/*ConvertBench.cpp*/
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "ConvertRaw.hpp"
+
+#define BENCH_WINDOWS 4096
+#define BENCH_ROUNDS 200
+
+template <typename T>
+using window_t = T[MODEL_INPUT_DIM_0][1];
+
+template <typename T, typename Fn>
+static double time_windows(const std::vector<int16_t> &raw, std::vector<T> &out, Fn convert)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < BENCH_ROUNDS; ++round)
+    {
+        for (size_t w = 0; w < BENCH_WINDOWS; ++w)
+        {
+            convert(raw.data() + w * MODEL_INPUT_DIM_0, *reinterpret_cast<window_t<T> *>(out.data() + w * MODEL_INPUT_DIM_0), MODEL_INPUT_DIM_0);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(BENCH_ROUNDS) * BENCH_WINDOWS);
+}
+
+template <typename T>
+static bool bench_type(const char *name, const std::vector<int16_t> &raw)
+{
+    std::vector<T> ref(raw.size());
+    std::vector<T> out(raw.size());
+
+    double scalar_ns = time_windows<T>(raw, ref, convert_raw_data_scalar<T>);
+    double dispatch_ns = time_windows<T>(raw, out, convert_raw_data<T>);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < raw.size(); ++i)
+    {
+        if (ref[i] != out[i])
+            mismatches++;
+    }
+
+    std::cout << std::left << std::setw(10) << name
+              << std::setw(16) << scalar_ns
+              << std::setw(16) << dispatch_ns
+              << std::setw(10) << scalar_ns / dispatch_ns
+              << mismatches << '\n';
+
+    return mismatches == 0;
+}
+
+/* Reference preprocessing of the model thread before the fused kernels: convert, copy, sample_norm. */
+template <typename T>
+static void convert_then_norm(const int16_t *src, T dst[MODEL_INPUT_DIM_0][1], size_t count)
+{
+    T converted[MODEL_INPUT_DIM_0][1];
+    convert_raw_data_scalar(src, converted, count);
+    sample_norm(converted);
+    std::memcpy(dst, converted, sizeof(converted));
+}
+
+template <typename T>
+static bool bench_norm_type(const char *name, const std::vector<int16_t> &raw)
+{
+    std::vector<T> ref(raw.size());
+    std::vector<T> scalar(raw.size());
+    std::vector<T> out(raw.size());
+    std::vector<T> converted(raw.size());
+    std::vector<T> window(raw.size());
+
+    double ref_ns = time_windows<T>(raw, ref, convert_then_norm<T>);
+    time_windows<T>(raw, scalar, convert_normalize_raw_data_scalar<T>);
+    double fused_ns = time_windows<T>(raw, out, convert_normalize_raw_data<T>);
+
+    time_windows<T>(raw, converted, convert_raw_data_scalar<T>);
+    for (size_t w = 0; w < BENCH_WINDOWS; ++w)
+    {
+        auto *src = reinterpret_cast<const window_t<T> *>(converted.data() + w * MODEL_INPUT_DIM_0);
+        auto *dst = reinterpret_cast<window_t<T> *>(window.data() + w * MODEL_INPUT_DIM_0);
+        normalize_window(*src, *dst, MODEL_INPUT_DIM_0);
+    }
+
+    /* Dispatched kernels must match the scalar ones exactly; integer types must also match sample_norm,
+       floats may differ from its division by the rounding of the reciprocal. */
+    size_t mismatches = 0;
+    double max_ref_diff = 0.0;
+    for (size_t i = 0; i < raw.size(); ++i)
+    {
+        if (out[i] != scalar[i] || window[i] != scalar[i])
+            mismatches++;
+        double diff = std::fabs(static_cast<double>(out[i]) - static_cast<double>(ref[i]));
+        if (diff > max_ref_diff)
+            max_ref_diff = diff;
+    }
+    bool ref_ok = std::is_floating_point<T>::value ? max_ref_diff <= 1e-6 : max_ref_diff == 0.0;
+
+    std::cout << std::left << std::setw(10) << name
+              << std::setw(16) << ref_ns
+              << std::setw(16) << fused_ns
+              << std::setw(10) << ref_ns / fused_ns
+              << std::setw(12) << mismatches
+              << max_ref_diff << '\n';
+
+    return mismatches == 0 && ref_ok;
+}
+
+int main()
+{
+    /* Full 16-bit range first so every rounding and saturation case is compared, then random samples. */
+    std::vector<int16_t> raw(static_cast<size_t>(BENCH_WINDOWS) * MODEL_INPUT_DIM_0);
+    std::srand(1);
+    for (size_t i = 0; i < raw.size(); ++i)
+    {
+        raw[i] = (i < 65536) ? static_cast<int16_t>(i - 32768) : static_cast<int16_t>(std::rand() % 16384 - 8192);
+    }
+
+#if defined(__ARM_NEON)
+    const char *impl = "NEON";
+#else
+    const char *impl = "scalar";
+#endif
+    std::cout << "convert_raw_data: " << MODEL_INPUT_DIM_0 << " samples per window, dispatched implementation: " << impl << "\n\n";
+    std::cout << std::left << std::setw(10) << "type"
+              << std::setw(16) << "scalar ns/win"
+              << std::setw(16) << "dispatch ns/win"
+              << std::setw(10) << "speedup"
+              << "mismatches" << '\n';
+
+    bool ok = true;
+    ok &= bench_type<float>("float", raw);
+    ok &= bench_type<int8_t>("int8", raw);
+    ok &= bench_type<int16_t>("int16", raw);
+
+    std::cout << "\nconvert + sample_norm (reference) vs fused convert_normalize_raw_data\n\n";
+    std::cout << std::left << std::setw(10) << "type"
+              << std::setw(16) << "ref ns/win"
+              << std::setw(16) << "fused ns/win"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "mismatches"
+              << "max diff vs ref" << '\n';
+
+    ok &= bench_norm_type<float>("float", raw);
+    ok &= bench_norm_type<int8_t>("int8", raw);
+    ok &= bench_norm_type<int16_t>("int16", raw);
+
+    return ok ? 0 : 1;
+}
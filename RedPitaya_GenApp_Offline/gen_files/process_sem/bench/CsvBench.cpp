@@ -0,0 +1,148 @@
+/*CsvBench.cpp*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CsvFormat.hpp"
+
+#define BENCH_WINDOWS 2048
+#define BENCH_ROUNDS 20
+
+template <typename T>
+using window_t = T[MODEL_INPUT_DIM_0][1];
+
+/* The sinks' previous output: one printf per value. */
+template <typename T>
+static size_t format_window_printf(char *out, const window_t<T> &data)
+{
+    char *p = out;
+    for (size_t k = 0; k < MODEL_INPUT_DIM_0; ++k)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+            p += sprintf(p, "%.6f", data[k][0]);
+        else
+            p += sprintf(p, "%d", static_cast<int>(data[k][0]));
+        if (k < MODEL_INPUT_DIM_0 - 1)
+            *p++ = ',';
+    }
+    *p++ = '\n';
+    return static_cast<size_t>(p - out);
+}
+
+template <typename T>
+static void fill(std::vector<T> &values, std::mt19937 &rng)
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        /* Converted ADC codes, normalised values, and magnitudes and ties that stress the rounding. */
+        std::uniform_int_distribution<int> code(-8192, 8191);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> exponent(-12.0f, 12.0f);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            switch (i % 4)
+            {
+            case 0: values[i] = code(rng) / 8192.0f; break;
+            case 1: values[i] = unit(rng); break;
+            case 2: values[i] = unit(rng) * std::pow(10.0f, exponent(rng)); break;
+            default: values[i] = (code(rng) + 0.5f) * 1e-6f; break;
+            }
+        }
+    }
+    else
+    {
+        std::uniform_int_distribution<int> code(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+        for (auto &v : values)
+            v = static_cast<T>(code(rng));
+    }
+}
+
+template <typename T, typename Fn>
+static double time_format(const std::vector<T> &values, std::string &text, Fn format)
+{
+    std::vector<char> line(csv_window_chars<T>() + CSV_FLOAT_CHARS);
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < BENCH_ROUNDS; ++round)
+    {
+        text.clear();
+        for (size_t w = 0; w < BENCH_WINDOWS; ++w)
+        {
+            size_t length = format(line.data(), *reinterpret_cast<const window_t<T> *>(values.data() + w * MODEL_INPUT_DIM_0));
+            text.append(line.data(), length);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(BENCH_ROUNDS) * BENCH_WINDOWS);
+}
+
+template <typename T>
+static bool bench_type(const char *name, std::mt19937 &rng)
+{
+    std::vector<T> values(BENCH_WINDOWS * MODEL_INPUT_DIM_0);
+    fill(values, rng);
+
+    std::string ref, out;
+    double printf_ns = time_format<T>(values, ref, format_window_printf<T>);
+    double to_chars_ns = time_format<T>(values, out, format_window_csv<T>);
+    bool same = ref == out;
+
+    std::cout << std::left << std::setw(10) << name
+              << std::setw(16) << printf_ns
+              << std::setw(16) << to_chars_ns
+              << std::setw(10) << printf_ns / to_chars_ns
+              << (same ? "identical" : "DIFFERENT") << '\n';
+    return same;
+}
+
+static bool check_results(std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> value(-32768, 32767);
+    std::uniform_real_distribution<double> time_ms(0.0, 50.0);
+    char ref[CSV_RESULT_CHARS + 1];
+    char out[CSV_RESULT_CHARS];
+    size_t mismatches = 0;
+
+    for (int index = 1; index <= 100000; ++index)
+    {
+        int v = value(rng);
+        double t = time_ms(rng);
+        float f = v / 4096.0f;
+        size_t ref_len = snprintf(ref, sizeof(ref), "%d,%d,%.6f\n", index, v, t);
+        if (format_result_csv(out, index, static_cast<int16_t>(v), t) != ref_len || std::memcmp(ref, out, ref_len) != 0)
+            mismatches++;
+        ref_len = snprintf(ref, sizeof(ref), "%d,%.6f,%.6f\n", index, f, t);
+        if (format_result_csv(out, index, f, t) != ref_len || std::memcmp(ref, out, ref_len) != 0)
+            mismatches++;
+    }
+
+    std::cout << "\noutput_chX.csv lines (int16 and float outputs): " << mismatches << " mismatches in 200000\n";
+    return mismatches == 0;
+}
+
+int main()
+{
+    std::mt19937 rng(1);
+
+    std::cout << "data_chX.csv line formatting: " << MODEL_INPUT_DIM_0 << " samples per window, float path: "
+              << (CSV_TO_CHARS_FLOAT ? "std::to_chars" : "snprintf") << "\n\n";
+    std::cout << std::left << std::setw(10) << "type"
+              << std::setw(16) << "printf ns/win"
+              << std::setw(16) << "to_chars ns/win"
+              << std::setw(10) << "speedup"
+              << "output\n";
+
+    bool ok = bench_type<int8_t>("int8", rng);
+    ok &= bench_type<int16_t>("int16", rng);
+    ok &= bench_type<float>("float", rng);
+    ok &= check_results(rng);
+
+    return ok ? 0 : 1;
+}
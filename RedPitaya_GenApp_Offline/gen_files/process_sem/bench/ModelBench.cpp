@@ -0,0 +1,157 @@
+/*ModelBench.cpp*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Common.hpp"
+#include "LayerProfile.hpp"
+
+#define ADC_SAMPLE_RATE 125000000.0
+#define BENCH_DEFAULT_ITERATIONS 10000
+#define BENCH_RANDOM_WINDOWS 256
+
+struct window_t
+{
+    input_t data;
+};
+
+/* Windows from a DataOutput/data_chX.csv capture: one already converted window per line, gap markers skipped. */
+static bool load_windows(const char *path, std::vector<window_t> &windows)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::cerr << "Cannot open recorded windows: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        window_t window;
+        std::istringstream fields(line);
+        std::string field;
+        size_t i = 0;
+        while (i < MODEL_INPUT_DIM_0 && std::getline(fields, field, ','))
+            window.data[i++][0] = static_cast<number_t>(std::strtod(field.c_str(), nullptr));
+
+        if (i == MODEL_INPUT_DIM_0)
+            windows.push_back(window);
+    }
+
+    if (windows.empty())
+    {
+        std::cerr << "No complete " << MODEL_INPUT_DIM_0 << "-sample window in " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/* Random 14-bit ADC codes converted the same way acquire_data does. */
+static void random_windows(std::vector<window_t> &windows)
+{
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> code(-8192, 8191);
+    int16_t raw[MODEL_INPUT_DIM_0];
+
+    windows.resize(BENCH_RANDOM_WINDOWS);
+    for (auto &window : windows)
+    {
+        for (auto &sample : raw)
+            sample = static_cast<int16_t>(code(rng));
+        convert_raw_data(raw, window.data, MODEL_INPUT_DIM_0);
+    }
+}
+
+static double percentile(const std::vector<double> &sorted, double fraction)
+{
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : BENCH_DEFAULT_ITERATIONS;
+    if (iterations <= 0)
+    {
+        std::cerr << "Usage: " << argv[0] << " [iterations] [DataOutput/data_chX.csv]" << std::endl;
+        return 2;
+    }
+
+    std::vector<window_t> windows;
+    if (argc > 2)
+    {
+        if (!load_windows(argv[2], windows))
+            return 2;
+    }
+    else
+    {
+        random_windows(windows);
+    }
+
+#if PROFILE_LAYERS
+    static layer_profile_t profile;
+    layer_profile_attach(&profile);
+#endif
+
+    output_t output;
+    for (size_t i = 0; i < std::min<size_t>(windows.size(), 16); ++i)
+        cnn(windows[i].data, output);
+
+    std::vector<double> latency_us(iterations);
+    auto bench_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        cnn(windows[i % windows.size()].data, output);
+        auto end = std::chrono::steady_clock::now();
+        latency_us[i] = std::chrono::duration<double, std::micro>(end - start).count();
+    }
+    auto bench_end = std::chrono::steady_clock::now();
+    double elapsed_s = std::chrono::duration<double>(bench_end - bench_start).count();
+
+    std::vector<double> sorted = latency_us;
+    std::sort(sorted.begin(), sorted.end());
+    double mean = 0.0;
+    for (double v : latency_us)
+        mean += v;
+    mean /= iterations;
+
+    double period_us = MODEL_INPUT_DIM_0 * DECIMATION / ADC_SAMPLE_RATE * 1e6;
+    double p99 = percentile(sorted, 0.99);
+
+    std::cout << "cnn(): " << iterations << " runs over " << windows.size() << (argc > 2 ? " recorded" : " random")
+              << " windows of " << MODEL_INPUT_DIM_0 << " samples\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(30) << "Mean latency (us):" << mean << '\n';
+    std::cout << std::left << std::setw(30) << "p50 latency (us):" << percentile(sorted, 0.50) << '\n';
+    std::cout << std::left << std::setw(30) << "p99 latency (us):" << p99 << '\n';
+    std::cout << std::left << std::setw(30) << "Max latency (us):" << sorted.back() << '\n';
+    std::cout << std::left << std::setw(30) << "Throughput (windows/s):" << iterations / elapsed_s << '\n';
+    std::cout << std::left << std::setw(30) << "Window period (us):" << period_us << " at DECIMATION " << DECIMATION << '\n';
+    std::cout << std::defaultfloat;
+
+#if PROFILE_LAYERS
+    print_layer_profile(profile, "cnn()");
+#endif
+
+    if (p99 > period_us)
+    {
+        std::cout << "\nModel cannot keep up: p99 latency exceeds the window period." << std::endl;
+        return 1;
+    }
+    std::cout << "\nModel keeps up with " << std::fixed << std::setprecision(1) << 100.0 * (1.0 - p99 / period_us)
+              << "% headroom at p99." << std::endl;
+    return 0;
+}
@@ -3,4 +3,5 @@
 #include "Common.hpp"
 
 void initialize_acq();
-void cleanup();
\ No newline at end of file
+void cleanup();
+const int16_t *axi_channel_buffer(rp_channel_t channel);
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*BroadcastRing.hpp*/
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <semaphore.h>
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+/*
+ * Fixed-capacity single-producer/multi-consumer broadcast ring. Slots are
+ * preallocated and written in place by the producer (claim() then publish());
+ * every reader registered with add_reader() owns its own cursor and sees every
+ * published slot. A slot is only reused once the slowest cursor has passed it.
+ * Readers sleep on their own semaphore, which the producer posts only when the
+ * reader announced it found the ring empty.
+ */
+template <typename T, size_t Capacity, size_t MaxReaders = 4>
+class BroadcastRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "BroadcastRing capacity must be a power of two");
+
+public:
+    /* Must be called before the producer and readers start. Returns the reader id, or -1 if full. */
+    int add_reader(sem_t *sem)
+    {
+        if (reader_count_ == MaxReaders)
+            return -1;
+        reader_t &reader = readers_[reader_count_];
+        reader.cursor.store(tail_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        reader.sleeping.store(false, std::memory_order_relaxed);
+        reader.sem = sem;
+        return static_cast<int>(reader_count_++);
+    }
+
+    size_t reader_count() const { return reader_count_; }
+
+    /* The reader holding the oldest slot, i.e. the one a failed claim() is waiting for. */
+    int slowest_reader() const
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        int slowest = -1;
+        size_t lag = 0;
+        for (size_t i = 0; i < reader_count_; ++i)
+        {
+            size_t behind = tail - readers_[i].cursor.load(std::memory_order_acquire);
+            if (slowest < 0 || behind > lag)
+            {
+                slowest = static_cast<int>(i);
+                lag = behind;
+            }
+        }
+        return slowest;
+    }
+
+    T *claim()
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_min_ >= Capacity)
+        {
+            cached_min_ = min_cursor(tail);
+            if (tail - cached_min_ >= Capacity)
+                return nullptr;
+        }
+        return &slots_[tail & (Capacity - 1)];
+    }
+
+    void publish()
+    {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (size_t i = 0; i < reader_count_; ++i)
+        {
+            reader_t &reader = readers_[i];
+            if (reader.sleeping.load(std::memory_order_relaxed) && reader.sleeping.exchange(false, std::memory_order_acq_rel))
+                sem_post(reader.sem);
+        }
+    }
+
+    /* End of stream: wakes every reader regardless of its sleeping flag. */
+    void wake_all()
+    {
+        for (size_t i = 0; i < reader_count_; ++i)
+            sem_post(readers_[i].sem);
+    }
+
+    const T *peek(int id) const
+    {
+        const reader_t &reader = readers_[id];
+        size_t cursor = reader.cursor.load(std::memory_order_relaxed);
+        if (cursor == tail_.load(std::memory_order_acquire))
+            return nullptr;
+        return &slots_[cursor & (Capacity - 1)];
+    }
+
+    /* Slot offset entries past the reader's cursor, or null if not published yet. */
+    const T *peek(int id, size_t offset) const
+    {
+        const reader_t &reader = readers_[id];
+        size_t cursor = reader.cursor.load(std::memory_order_relaxed);
+        if (tail_.load(std::memory_order_acquire) - cursor <= offset)
+            return nullptr;
+        return &slots_[(cursor + offset) & (Capacity - 1)];
+    }
+
+    void consume(int id, size_t count = 1)
+    {
+        reader_t &reader = readers_[id];
+        reader.cursor.store(reader.cursor.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    bool empty(int id) const
+    {
+        return readers_[id].cursor.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t size(int id) const
+    {
+        return tail_.load(std::memory_order_acquire) - readers_[id].cursor.load(std::memory_order_relaxed);
+    }
+
+    /* Blocks until data is published or the semaphore is posted externally. Returns false on EINTR. */
+    bool wait(int id)
+    {
+        reader_t &reader = readers_[id];
+        reader.sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!empty(id))
+        {
+            reader.sleeping.store(false, std::memory_order_relaxed);
+            return true;
+        }
+        int rc = sem_wait(reader.sem);
+        reader.sleeping.store(false, std::memory_order_relaxed);
+        return rc == 0 || errno != EINTR;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) reader_t
+    {
+        std::atomic<size_t> cursor{0};
+        std::atomic<bool> sleeping{false};
+        sem_t *sem = nullptr;
+    };
+
+    size_t min_cursor(size_t tail) const
+    {
+        size_t min = tail;
+        for (size_t i = 0; i < reader_count_; ++i)
+        {
+            size_t cursor = readers_[i].cursor.load(std::memory_order_acquire);
+            if (tail - cursor > tail - min)
+                min = cursor;
+        }
+        return min;
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cached_min_ = 0;
+    size_t reader_count_ = 0;
+
+    reader_t readers_[MaxReaders];
+
+    alignas(CACHE_LINE_SIZE) T slots_[Capacity];
+};
@@ -0,0 +1,75 @@
+/*BufferedWriter.hpp*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Common.hpp"
+
+/*
+ * Output file fed by one sink thread. The sink formats into the active one of two
+ * page-aligned WRITER_BUFFER_SIZE buffers; a full buffer, or one older than
+ * WRITER_FLUSH_INTERVAL_MS, is handed to the writer's own I/O thread, which writes
+ * it out and applies the WRITER_DURABILITY policy. The sink only blocks when it
+ * fills the second buffer before the first one is on disk. rotate() switches to a new
+ * file without waiting: the I/O thread finishes the old one first.
+ */
+class BufferedWriter
+{
+public:
+    BufferedWriter(const std::string &path, shared_counters_t *counters);
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+    bool is_open() const { return fd_ >= 0; }
+    bool failed() const { return failed_; }
+
+    /* Bytes committed to the current file so far. */
+    uint64_t offset() const { return offset_; }
+
+    /* Space for at most size bytes in the active buffer; commit() the part actually used. */
+    char *reserve(size_t size);
+    void commit(size_t size);
+
+    void write(const void *data, size_t size);
+    void print(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    /* Hands the active buffer to the I/O thread if WRITER_FLUSH_INTERVAL_MS has passed since it was started. */
+    void flush_if_due();
+
+    /* Ends the current file like close() does and continues in path. */
+    void rotate(const std::string &path);
+
+    /* Writes everything out, applies the durability policy and closes the file. */
+    void close();
+
+private:
+    void submit(const std::string *next_path = nullptr);
+    void io_loop();
+    void switch_file(const std::string &path);
+
+    int fd_ = -1;
+    std::atomic<bool> failed_{false};
+    shared_counters_t *counters_;
+
+    char *buffers_[2] = {nullptr, nullptr};
+    char *active_ = nullptr;
+    size_t used_ = 0;
+    uint64_t offset_ = 0;
+    std::chrono::steady_clock::time_point active_since_;
+
+    std::mutex lock_;
+    std::condition_variable cv_;
+    char *pending_ = nullptr;
+    size_t pending_size_ = 0;
+    std::string pending_path_;
+    bool stopping_ = false;
+    std::thread io_thread_;
+};
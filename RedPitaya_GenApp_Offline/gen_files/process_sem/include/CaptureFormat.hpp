@@ -0,0 +1,75 @@
+/*CaptureFormat.hpp*/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "../model/include/model.h"
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "The binary capture format is written little-endian straight from memory"
+#endif
+
+/*
+ * DataOutput/data_chX.bin: one capture_header_t, then records. Every record starts with a
+ * capture_record_t; a window record carries window_samples values of sample_type, a Rice
+ * window record the same samples coded as in RiceCodec.hpp (make CAPTURE_COMPRESS=1), and a
+ * gap record a capture_gap_t. All fields are little-endian and the structs have no padding.
+ */
+#define CAPTURE_MAGIC "RPCAPT\r\n"
+#define CAPTURE_VERSION 1
+
+#define CAPTURE_SAMPLE_INT8 1
+#define CAPTURE_SAMPLE_INT16 2
+#define CAPTURE_SAMPLE_FLOAT32 3
+
+#define CAPTURE_RECORD_WINDOW 1
+#define CAPTURE_RECORD_GAP 2
+#define CAPTURE_RECORD_WINDOW_RICE 3
+
+struct __attribute__((packed)) capture_header_t
+{
+    char magic[8];
+    uint16_t version;
+    uint16_t header_size;
+    uint8_t channel;
+    uint8_t sample_type;
+    uint16_t sample_size;
+    uint32_t window_samples;
+    uint32_t hop_samples;
+    uint32_t decimation;
+    double sample_rate_hz;
+    uint64_t trigger_monotonic_ns;
+    uint64_t trigger_unix_ns;
+};
+
+/* seq is the acquisition window number, so windows dropped on a full ring show up as holes; a gap takes the number of the window after it. */
+struct __attribute__((packed)) capture_record_t
+{
+    uint32_t type;
+    uint32_t size;
+    uint64_t seq;
+};
+
+struct __attribute__((packed)) capture_gap_t
+{
+    uint64_t gap_samples;
+    uint64_t gap_time_ns;
+};
+
+static_assert(sizeof(capture_header_t) == 52, "capture_header_t layout changed");
+static_assert(sizeof(capture_record_t) == 16, "capture_record_t layout changed");
+
+template <typename T>
+constexpr uint8_t capture_sample_type()
+{
+    if constexpr (std::is_same_v<T, int8_t>)
+        return CAPTURE_SAMPLE_INT8;
+    else if constexpr (std::is_same_v<T, int16_t>)
+        return CAPTURE_SAMPLE_INT16;
+    else if constexpr (std::is_same_v<T, float>)
+        return CAPTURE_SAMPLE_FLOAT32;
+    else
+        static_assert(!sizeof(T *), "Unsupported data type in the binary capture.");
+}
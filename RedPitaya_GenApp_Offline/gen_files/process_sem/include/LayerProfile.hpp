@@ -0,0 +1,9 @@
+/*LayerProfile.hpp*/
+
+#pragma once
+
+#include "Common.hpp"
+#include "LayerProfile.h"
+
+void print_layer_profile(const layer_profile_t &profile, const char *label);
+void print_layer_profile(const shared_counters_t *counters);
@@ -0,0 +1,52 @@
+/*LayerProfileShim.h*/
+
+/*
+ * Force-included into model.c by "make PROFILE_LAYERS=1". Every CMSIS-NN kernel the bundle provides is
+ * redirected through LAYER_PROFILE_CALL so each call site in the generated code gets its own timing slot.
+ * arm_nnfunctions.h is pulled in first so the prototypes are declared before the wrappers are defined.
+ */
+
+#pragma once
+
+#include "arm_nnfunctions.h"
+#include "LayerProfile.h"
+
+#define LAYER_PROFILE_SITE(name)                                 \
+    static int layer_profile_site_ = -1;                         \
+    if (layer_profile_site_ < 0)                                 \
+        layer_profile_site_ = layer_profile_register(name, __LINE__)
+
+#define LAYER_PROFILE_CALL(name, call)                                                   \
+    __extension__({                                                                      \
+        LAYER_PROFILE_SITE(name);                                                        \
+        uint64_t layer_profile_start_ = layer_profile_ticks();                           \
+        __typeof__(call) layer_profile_ret_ = call;                                      \
+        layer_profile_record(layer_profile_site_, layer_profile_ticks() - layer_profile_start_); \
+        layer_profile_ret_;                                                              \
+    })
+
+#define LAYER_PROFILE_VOID(name, call)                                                   \
+    __extension__({                                                                      \
+        LAYER_PROFILE_SITE(name);                                                        \
+        uint64_t layer_profile_start_ = layer_profile_ticks();                           \
+        call;                                                                            \
+        layer_profile_record(layer_profile_site_, layer_profile_ticks() - layer_profile_start_); \
+    })
+
+/*
+ * A function-like macro does not expand inside its own replacement, so the inner name is the real kernel.
+ * The bundled kernel sources, which model.c may #include, declare their definitions as (arm_xxx)(...) so
+ * they are not rewritten either.
+ */
+#define arm_convolve_HWC_q15_basic_nonsquare(...) LAYER_PROFILE_CALL("arm_convolve_HWC_q15_basic_nonsquare", arm_convolve_HWC_q15_basic_nonsquare(__VA_ARGS__))
+#define arm_convolve_HWC_q15_basic_nonsquare_batch(...) LAYER_PROFILE_CALL("arm_convolve_HWC_q15_basic_nonsquare_batch", arm_convolve_HWC_q15_basic_nonsquare_batch(__VA_ARGS__))
+#define arm_convolve_HWC_q15_fast_nonsquare(...) LAYER_PROFILE_CALL("arm_convolve_HWC_q15_fast_nonsquare", arm_convolve_HWC_q15_fast_nonsquare(__VA_ARGS__))
+#define arm_convolve_s8(...) LAYER_PROFILE_CALL("arm_convolve_s8", arm_convolve_s8(__VA_ARGS__))
+#define arm_fully_connected_q15(...) LAYER_PROFILE_CALL("arm_fully_connected_q15", arm_fully_connected_q15(__VA_ARGS__))
+#define arm_fully_connected_q15_batch(...) LAYER_PROFILE_CALL("arm_fully_connected_q15_batch", arm_fully_connected_q15_batch(__VA_ARGS__))
+#define arm_fully_connected_s8(...) LAYER_PROFILE_CALL("arm_fully_connected_s8", arm_fully_connected_s8(__VA_ARGS__))
+#define arm_max_pool_s8(...) LAYER_PROFILE_CALL("arm_max_pool_s8", arm_max_pool_s8(__VA_ARGS__))
+#define arm_avgpool_s8(...) LAYER_PROFILE_CALL("arm_avgpool_s8", arm_avgpool_s8(__VA_ARGS__))
+#define arm_relu_q7(...) LAYER_PROFILE_VOID("arm_relu_q7", arm_relu_q7(__VA_ARGS__))
+#define arm_relu6_s8(...) LAYER_PROFILE_VOID("arm_relu6_s8", arm_relu6_s8(__VA_ARGS__))
+#define arm_relu_q15(...) LAYER_PROFILE_VOID("arm_relu_q15", arm_relu_q15(__VA_ARGS__))
@@ -0,0 +1,193 @@
+/*RiceCodec.hpp*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * Lossless window codec of the compressed binary capture: first-order delta, zigzag, then
+ * Golomb-Rice codes with one parameter k per window. Payload: k (one byte), then the codes
+ * packed LSB-first. A code is q = u >> k one-bits, a zero and the k low bits of u; a quotient
+ * of RICE_ESCAPE or more is sent as RICE_ESCAPE one-bits followed by u in 32 bits.
+ * Every window starts from zero, so each record decodes on its own.
+ */
+#define RICE_ESCAPE 24
+#define RICE_MAX_K 24
+
+/* Worst case payload for count samples, every one escaped. */
+#define RICE_MAX_BYTES(count) (1 + ((count) * (RICE_ESCAPE + 32) + 7) / 8)
+
+inline uint32_t rice_zigzag(int32_t v)
+{
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int32_t rice_unzigzag(uint32_t u)
+{
+    return static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1);
+}
+
+/* Smallest total code length over k around log2 of the mean residual. */
+inline int rice_choose_k(const uint32_t *u, size_t count)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; ++i)
+        sum += u[i];
+
+    uint64_t mean = count ? sum / count : 0;
+    int guess = mean ? 64 - __builtin_clzll(mean) - 1 : 0;
+
+    int best_k = 0;
+    uint64_t best_bits = UINT64_MAX;
+    for (int k = guess > 0 ? guess - 1 : 0; k <= guess + 1 && k <= RICE_MAX_K; ++k)
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t q = u[i] >> k;
+            bits += q < RICE_ESCAPE ? q + 1 + k : RICE_ESCAPE + 32;
+        }
+        if (bits < best_bits)
+        {
+            best_bits = bits;
+            best_k = k;
+        }
+    }
+    return best_k;
+}
+
+struct rice_bit_writer_t
+{
+    uint8_t *out;
+    size_t pos = 0;
+    uint64_t acc = 0;
+    int bits = 0;
+
+    void put(uint32_t value, int count)
+    {
+        acc |= static_cast<uint64_t>(value) << bits;
+        bits += count;
+        while (bits >= 8)
+        {
+            out[pos++] = static_cast<uint8_t>(acc);
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+
+    size_t finish()
+    {
+        if (bits > 0)
+            out[pos++] = static_cast<uint8_t>(acc);
+        return pos;
+    }
+};
+
+struct rice_bit_reader_t
+{
+    const uint8_t *in;
+    size_t size;
+    size_t pos = 0;
+    uint64_t acc = 0;
+    int bits = 0;
+
+    bool fill(int count)
+    {
+        while (bits < count)
+        {
+            if (pos == size)
+                return false;
+            acc |= static_cast<uint64_t>(in[pos++]) << bits;
+            bits += 8;
+        }
+        return true;
+    }
+
+    bool get(int count, uint32_t &value)
+    {
+        if (!fill(count))
+            return false;
+        value = static_cast<uint32_t>(acc & ((1ULL << count) - 1));
+        acc >>= count;
+        bits -= count;
+        return true;
+    }
+};
+
+/* Integer windows only; out needs RICE_MAX_BYTES(Count). Returns the payload size. */
+template <typename T, size_t Count>
+inline size_t rice_encode(const T (&window)[Count][1], uint8_t *out)
+{
+    static_assert(std::is_integral_v<T> && sizeof(T) <= 2, "Rice capture coding needs 8 or 16-bit integer samples");
+
+    uint32_t u[Count];
+    int32_t previous = 0;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        u[i] = rice_zigzag(static_cast<int32_t>(window[i][0]) - previous);
+        previous = window[i][0];
+    }
+
+    int k = rice_choose_k(u, Count);
+    out[0] = static_cast<uint8_t>(k);
+
+    rice_bit_writer_t writer{out + 1};
+    for (size_t i = 0; i < Count; ++i)
+    {
+        uint32_t q = u[i] >> k;
+        if (q < RICE_ESCAPE)
+        {
+            writer.put((1u << q) - 1, static_cast<int>(q) + 1);
+            if (k)
+                writer.put(u[i] & ((1u << k) - 1), k);
+        }
+        else
+        {
+            writer.put((1u << RICE_ESCAPE) - 1, RICE_ESCAPE);
+            writer.put(u[i], 32);
+        }
+    }
+    return 1 + writer.finish();
+}
+
+template <typename T, size_t Count>
+inline bool rice_decode(const uint8_t *in, size_t size, T (&window)[Count][1])
+{
+    if (size < 1 || in[0] > RICE_MAX_K)
+        return false;
+
+    int k = in[0];
+    rice_bit_reader_t reader{in + 1, size - 1};
+    int32_t previous = 0;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        uint32_t q = 0, bit = 0, u = 0;
+        while (q < RICE_ESCAPE)
+        {
+            if (!reader.get(1, bit))
+                return false;
+            if (!bit)
+                break;
+            q++;
+        }
+
+        if (q == RICE_ESCAPE)
+        {
+            if (!reader.get(32, u))
+                return false;
+        }
+        else
+        {
+            uint32_t low = 0;
+            if (k && !reader.get(k, low))
+                return false;
+            u = (q << k) | low;
+        }
+
+        previous += rice_unzigzag(u);
+        window[i][0] = static_cast<T>(previous);
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+/*SegmentedWriter.hpp*/
+
+#pragma once
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "BufferedWriter.hpp"
+
+/*
+ * BufferedWriter that splits its output into segments when WRITER_SEGMENT_MB or
+ * WRITER_SEGMENT_SECONDS is set: DataOutput/data_ch1.bin becomes data_ch1.000000.bin,
+ * data_ch1.000001.bin, ... Numbering continues after segments left by a previous run.
+ *
+ * Next to the segments, data_ch1.bin.idx gets one text line per segment start and
+ * per WRITER_INDEX_INTERVAL_MS of data:
+ *
+ *     segment,seq,time_ns,offset
+ *
+ * seq is the acquisition sequence number of the record at byte offset in that
+ * segment and time_ns its time since the trigger, as in the "# gap" lines. Each
+ * run first appends "# trigger,<unix ns>". Offset 0 is the start of the file,
+ * so a binary capture reader meets the segment's header first.
+ *
+ * Closed segments are handed to delete_oldest_segment(), which the disk monitor
+ * uses under WRITER_RETENTION.
+ */
+class SegmentedWriter : public BufferedWriter
+{
+public:
+    SegmentedWriter(const std::string &path, shared_counters_t *counters);
+    ~SegmentedWriter();
+
+    /* Call before each record; true when it is the first record of a file, which then needs its header again. */
+    bool begin_record(uint64_t seq, uint64_t time_ns);
+
+    void close();
+
+    /* Time since the trigger of a window's CLOCK_MONOTONIC acquisition time. */
+    uint64_t since_trigger(uint64_t acq_time_ns) const;
+
+private:
+    struct segment_files_t
+    {
+        std::string path;
+        std::string stem;
+        std::string extension;
+        std::vector<std::string> existing;
+        unsigned next = 0;
+    };
+
+    SegmentedWriter(segment_files_t files, shared_counters_t *counters);
+
+    static segment_files_t find_segments(const std::string &path);
+    static std::string segment_path(const segment_files_t &files, unsigned number);
+
+    void add_index_entry(uint64_t seq, uint64_t time_ns);
+
+    segment_files_t files_;
+    shared_counters_t *counters_;
+    unsigned segment_ = 0;
+    bool started_ = false;
+    uint64_t segment_start_ns_ = 0;
+    uint64_t last_index_ns_ = 0;
+    std::FILE *index_ = nullptr;
+};
+
+/* True for segment and index files, which folder_manager keeps when output is segmented. */
+bool is_segment_file(const std::filesystem::path &path);
+
+/* Deletes the oldest closed segment of this process; false when there is none. */
+bool delete_oldest_segment();
@@ -3,6 +3,7 @@ import matplotlib.pyplot as plt
 import numpy as np
 import os
 from scipy import integrate
+from capture_to_csv import segment_paths
 
 # Define file paths
 buffer_file_paths = ['DataOutput/data_ch1.csv', 'DataOutput/data_ch2.csv']
@@ -11,18 +12,61 @@ output_file_paths = ['ModelOutput/output_ch1.csv', 'ModelOutput/output_ch2.csv']
 # Track available plots
 available_plots = []
 
+# Reads file_path, or its segments stem.NNNNNN.csv in order when the writers split their files
+# (WRITER_SEGMENT_MB / WRITER_SEGMENT_SECONDS); returns None when there is nothing to read.
+def load_csv(file_path, **read_args):
+    frames = [pd.read_csv(path, **read_args) for path in segment_paths(file_path) if os.path.getsize(path) > 0]
+    return pd.concat(frames, ignore_index=True) if frames else None
+
+# Flattens the windows of a data CSV into one sample stream. With MODEL_HOP_SIZE below the window
+# length, each file starts with "# hop,<hop>,<seq of its first window>" and consecutive windows
+# overlap: a window that follows on from the previous one only adds its last hop samples. After a
+# "# gap" line, or when a file does not continue the previous one's sequence, it is kept whole.
+# Returns the samples and the number of new samples per model output.
+def load_samples(file_path):
+    windows = []
+    hop = None
+    follows = False
+    next_seq = None
+    for path in segment_paths(file_path):
+        with open(path) as file:
+            for line in file:
+                if line.startswith('# hop,'):
+                    _, hop, seq = line.split(',')
+                    hop, seq = int(hop), int(seq)
+                    follows = follows and seq == next_seq
+                    next_seq = seq
+                elif line.startswith('# gap'):
+                    follows = False
+                elif line.strip() and not line.startswith('#'):
+                    window = np.array(line.split(','), dtype=float)
+                    windows.append(window[-hop:] if hop and follows else window)
+                    follows = True
+                    if next_seq is not None:
+                        next_seq += 1
+    if not windows:
+        return None, None
+    return np.concatenate(windows), hop or len(windows[0])
+
 # Load buffer data
 buffer_data = {}
+samples_per_output = 48
 for i, file_path in enumerate(buffer_file_paths):
-    if os.path.exists(file_path) and os.path.getsize(file_path) > 0:
-        buffer_data[i] = pd.read_csv(file_path, header=None)
+    data, samples_per_output_ch = load_samples(file_path)
+    if data is not None:
+        buffer_data[i] = data
+        samples_per_output = samples_per_output_ch
         available_plots.append(f"Buffer CH{i+1}")
 
 # Load output data
 output_data = {}
 for i, file_path in enumerate(output_file_paths):
-    if os.path.exists(file_path) and os.path.getsize(file_path) > 0:
-        output_data[i] = pd.read_csv(file_path, header=None, skiprows=1, dtype=float, skipinitialspace=True)
+    data = load_csv(file_path, header=None, dtype=float, skipinitialspace=True, comment='#')
+    if data is not None and len(data) > 1:
+        # Segments kept from earlier runs restart the output index, so number the stitched rows again
+        data = data.iloc[1:].reset_index(drop=True)
+        data[0] = np.arange(2, len(data) + 2)
+        output_data[i] = data
         available_plots.append(f"Output CH{i+1}")
 
 # Determine the number of plots needed
@@ -43,11 +87,10 @@ acquired_sample_axes = []
 output_axes = []
 
 # Plot buffer data
-for i, data in buffer_data.items():
-    flattened_data = data.values.flatten()
-    indices = np.arange(len(flattened_data))
+for i, samples in buffer_data.items():
+    indices = np.arange(len(samples))
 
-    axs[plot_index].plot(indices, flattened_data, marker='o', linestyle='-', markersize=2, label=f'Amplitudes CH{i+1}')
+    axs[plot_index].plot(indices, samples, marker='o', linestyle='-', markersize=2, label=f'Amplitudes CH{i+1}')
     axs[plot_index].set_title(f'Visualization of Acquired Samples CH{i+1}', fontsize=12)
     axs[plot_index].set_xlabel('Sample Index', fontsize=8)
     axs[plot_index].set_ylabel('Amplitude', fontsize=8)
@@ -119,11 +162,11 @@ def on_xlims_change(event_ax):
     xlim = event_ax.get_xlim()
 
     if event_ax in acquired_sample_axes:
-        # Acquired samples should be zoomed out 48x relative to output graphs
+        # Acquired samples should be zoomed out samples_per_output times relative to output graphs
         for ax in acquired_sample_axes:
             ax.set_xlim(xlim)
 
-        output_xlim = (xlim[0] / 48, xlim[1] / 48)
+        output_xlim = (xlim[0] / samples_per_output, xlim[1] / samples_per_output)
         for ax in output_axes:
             ax.set_xlim(output_xlim)
 
@@ -132,7 +175,7 @@ def on_xlims_change(event_ax):
         for ax in output_axes:
             ax.set_xlim(xlim)
 
-        acquired_xlim = (xlim[0] * 48, xlim[1] * 48)
+        acquired_xlim = (xlim[0] * samples_per_output, xlim[1] * samples_per_output)
         for ax in acquired_sample_axes:
             ax.set_xlim(acquired_xlim)
 
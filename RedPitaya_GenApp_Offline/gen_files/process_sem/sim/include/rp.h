@@ -0,0 +1,119 @@
+/*rp.h (simulated backend)*/
+
+/*
+ * Host replacement for the subset of librp used by gen_files (make SIM=1).
+ * Names and signatures follow /opt/redpitaya/include/rp.h so the sources
+ * build unchanged; only the functions the pipeline calls are provided.
+ *
+ * Runtime configuration is read from the environment on rp_Init():
+ *   RP_SIM_WAVEFORM       sine | square | triangle | noise | file   (default sine)
+ *   RP_SIM_FILE           samples to replay when RP_SIM_WAVEFORM=file, separated
+ *                         by commas/whitespace, '#' lines skipped (e.g. a
+ *                         DataOutput/data_chX.csv from a board run)
+ *   RP_SIM_FILE_SCALE     ADC codes per file unit (default: 8192 if the file has
+ *                         fractional values, i.e. volts or float model input,
+ *                         1 for integer ADC codes; 64 for an int8 model's CSV)
+ *   RP_SIM_FREQ_HZ        synthetic waveform frequency            (default 1000)
+ *   RP_SIM_AMPLITUDE      synthetic amplitude in volts            (default 0.5)
+ *   RP_SIM_CLOCK_SCALE    write pointer speed relative to 125 MHz/decimation (default 1.0)
+ *   RP_SIM_TRIGGER_MS     delay between rp_AcqStartCh and the trigger (default 0)
+ *   RP_SIM_DAC_CAPTURE    file prefix; rp_GenAmp values are kept in memory and
+ *                         written to <prefix>_chN.csv when the process exits
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define RP_OK 0
+#define RP_EOOR 2
+#define RP_EOMD 5
+#define RP_EUF 13
+
+    typedef enum
+    {
+        RP_CH_1 = 0,
+        RP_CH_2 = 1
+    } rp_channel_t;
+
+    typedef enum
+    {
+        RP_T_CH_1 = 0,
+        RP_T_CH_2 = 1,
+        RP_T_CH_EXT = 2
+    } rp_channel_trigger_t;
+
+    typedef enum
+    {
+        RP_TRIG_SRC_DISABLED = 0,
+        RP_TRIG_SRC_NOW = 1,
+        RP_TRIG_SRC_CHA_PE = 2,
+        RP_TRIG_SRC_CHA_NE = 3,
+        RP_TRIG_SRC_CHB_PE = 4,
+        RP_TRIG_SRC_CHB_NE = 5,
+        RP_TRIG_SRC_EXT_PE = 6,
+        RP_TRIG_SRC_EXT_NE = 7,
+        RP_TRIG_SRC_AWG_PE = 8,
+        RP_TRIG_SRC_AWG_NE = 9
+    } rp_acq_trig_src_t;
+
+    typedef enum
+    {
+        RP_TRIG_STATE_TRIGGERED = 0,
+        RP_TRIG_STATE_WAITING = 1
+    } rp_acq_trig_state_t;
+
+    typedef enum
+    {
+        RP_WAVEFORM_SINE = 0,
+        RP_WAVEFORM_SQUARE = 1,
+        RP_WAVEFORM_TRIANGLE = 2,
+        RP_WAVEFORM_RAMP_UP = 3,
+        RP_WAVEFORM_RAMP_DOWN = 4,
+        RP_WAVEFORM_DC = 5,
+        RP_WAVEFORM_PWM = 6,
+        RP_WAVEFORM_ARBITRARY = 7,
+        RP_WAVEFORM_DC_NEG = 8,
+        RP_WAVEFORM_SWEEP = 9
+    } rp_waveform_t;
+
+    int rp_Init(void);
+    int rp_Release(void);
+
+    int rp_AcqReset(void);
+    int rp_AcqSetSplitTrigger(bool enable);
+    int rp_AcqSetSplitTriggerPass(bool enable);
+    int rp_AcqGetSamplingRateHz(float *sampling_rate);
+    int rp_AcqSetTriggerLevel(rp_channel_trigger_t channel, float voltage);
+    int rp_AcqSetTriggerSrcCh(rp_channel_t channel, rp_acq_trig_src_t source);
+    int rp_AcqGetTriggerStateCh(rp_channel_t channel, rp_acq_trig_state_t *state);
+    int rp_AcqStartCh(rp_channel_t channel);
+    int rp_AcqStopCh(rp_channel_t channel);
+
+    int rp_AcqAxiGetMemoryRegion(uint32_t *start, uint32_t *size);
+    int rp_AcqAxiSetDecimationFactorCh(rp_channel_t channel, uint32_t decimation);
+    int rp_AcqAxiSetTriggerDelay(rp_channel_t channel, int32_t decimated_data_num);
+    int rp_AcqAxiSetBufferSamples(rp_channel_t channel, uint32_t address, uint32_t samples);
+    int rp_AcqAxiEnable(rp_channel_t channel, bool enable);
+    int rp_AcqAxiGetWritePointer(rp_channel_t channel, uint32_t *pos);
+    int rp_AcqAxiGetWritePointerAtTrig(rp_channel_t channel, uint32_t *pos);
+    int rp_AcqAxiGetDataRaw(rp_channel_t channel, uint32_t pos, uint32_t *size, int16_t *buffer);
+
+    int rp_GenReset(void);
+    int rp_GenWaveform(rp_channel_t channel, rp_waveform_t type);
+    int rp_GenOutEnable(rp_channel_t channel);
+    int rp_GenTriggerOnly(rp_channel_t channel);
+    int rp_GenAmp(rp_channel_t channel, float amplitude);
+
+    /* Simulator only: the emulated DMA ring behind rp_AcqAxiSetBufferSamples, for zero-copy reads. */
+    const int16_t *rp_SimAxiGetBuffer(rp_channel_t channel);
+
+#ifdef __cplusplus
+}
+#endif
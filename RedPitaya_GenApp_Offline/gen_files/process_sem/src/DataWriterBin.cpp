@@ -0,0 +1,152 @@
+/* DataWriterBin.cpp */
+
+#include "DataWriterBin.hpp"
+#include "CaptureFormat.hpp"
+#include "SegmentedWriter.hpp"
+#include "RiceCodec.hpp"
+#include <iostream>
+#include <cstring>
+#include <time.h>
+
+static uint64_t clock_ns(clockid_t clock)
+{
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+using sample_t = std::remove_all_extents_t<input_t>;
+
+/* Written once the first record arrives, when the trigger time is known. */
+static void write_header(BufferedWriter &file, const Channel &channel)
+{
+    uint64_t trigger_ns = channel.counters->trigger_time_ns.load();
+    uint64_t now_mono = clock_ns(CLOCK_MONOTONIC);
+    uint64_t now_unix = clock_ns(CLOCK_REALTIME);
+
+    capture_header_t header{};
+    std::memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+    header.version = CAPTURE_VERSION;
+    header.header_size = sizeof(capture_header_t);
+    header.channel = static_cast<uint8_t>(&channel == &channel2 ? 2 : 1);
+    header.sample_type = capture_sample_type<sample_t>();
+    header.sample_size = sizeof(sample_t);
+    header.window_samples = MODEL_INPUT_DIM_0;
+    header.hop_samples = MODEL_HOP_SIZE;
+    header.decimation = DECIMATION;
+    header.sample_rate_hz = ADC_SAMPLE_RATE / DECIMATION;
+    header.trigger_monotonic_ns = trigger_ns;
+    header.trigger_unix_ns = now_unix - (now_mono > trigger_ns ? now_mono - trigger_ns : 0);
+
+    file.write(&header, sizeof(header));
+}
+
+/* Rice-coded in place in the writer's buffer; windows that would not shrink are stored as they are. */
+static void write_window(BufferedWriter &file, const data_part_t &part, shared_counters_t &counters)
+{
+    capture_record_t record{};
+    record.seq = part.seq;
+
+#if CAPTURE_COMPRESS
+    if constexpr (std::is_integral_v<sample_t>)
+    {
+        auto start = std::chrono::steady_clock::now();
+        char *slot = file.reserve(sizeof(record) + RICE_MAX_BYTES(MODEL_INPUT_DIM_0));
+        size_t size = rice_encode(part.data, reinterpret_cast<uint8_t *>(slot + sizeof(record)));
+        if (size < sizeof(part.data))
+        {
+            record.type = CAPTURE_RECORD_WINDOW_RICE;
+            record.size = static_cast<uint32_t>(size);
+            std::memcpy(slot, &record, sizeof(record));
+            file.commit(sizeof(record) + size);
+        }
+        else
+        {
+            size = sizeof(part.data);
+            record.type = CAPTURE_RECORD_WINDOW;
+            record.size = static_cast<uint32_t>(size);
+            std::memcpy(slot, &record, sizeof(record));
+            std::memcpy(slot + sizeof(record), part.data, size);
+            file.commit(sizeof(record) + size);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        counters.compress_raw_bytes.fetch_add(sizeof(record) + sizeof(part.data), std::memory_order_relaxed);
+        counters.compress_bytes.fetch_add(sizeof(record) + size, std::memory_order_relaxed);
+        counters.compress_total_ns.fetch_add(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()), std::memory_order_relaxed);
+        return;
+    }
+#else
+    (void)counters;
+#endif
+
+    record.type = CAPTURE_RECORD_WINDOW;
+    record.size = sizeof(part.data);
+    file.write(&record, sizeof(record));
+    file.write(part.data, sizeof(part.data));
+}
+
+void write_data_bin(Channel &channel, const std::string &filename)
+{
+    try
+    {
+        SegmentedWriter capture_file(filename, channel.counters);
+        if (!capture_file.is_open())
+        {
+            std::cerr << "Error opening binary capture file: " << filename << "\n";
+            return;
+        }
+
+        const int reader = channel.data_bin_reader;
+        const data_part_t *part = nullptr;
+
+        while (true)
+        {
+            if (!channel.data_ring.wait(reader))
+            {
+                if (stop_program.load())
+                    break;
+                continue;
+            }
+
+            while ((part = channel.data_ring.peek(reader)) != nullptr)
+            {
+                uint64_t time_ns = part->gap_samples ? part->gap_time_ns : capture_file.since_trigger(part->acq_time_ns);
+                if (capture_file.begin_record(part->seq, time_ns))
+                    write_header(capture_file, channel);
+
+                capture_record_t record{};
+                record.seq = part->seq;
+                if (part->gap_samples)
+                {
+                    capture_gap_t gap{part->gap_samples, part->gap_time_ns};
+                    record.type = CAPTURE_RECORD_GAP;
+                    record.size = sizeof(gap);
+                    capture_file.write(&record, sizeof(record));
+                    capture_file.write(&gap, sizeof(gap));
+                }
+                else
+                {
+                    write_window(capture_file, *part, *channel.counters);
+                    channel.counters->write_count_bin.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                channel.data_ring.consume(reader);
+            }
+            capture_file.flush_if_due();
+
+            if (channel.acquisition_done && channel.data_ring.empty(reader))
+                break;
+        }
+
+        capture_file.close();
+        if (capture_file.failed())
+            std::cerr << "Error writing binary capture file: " << filename << "\n";
+        std::cout << "Data writing on binary capture thread on channel " << static_cast<int>(channel.channel_id) + 1 << " exiting..." << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Exception in write_data_bin for channel " << static_cast<int>(channel.channel_id) + 1 << ": " << e.what() << std::endl;
+    }
+}
@@ -3,7 +3,7 @@
 #include "ModelProcessing.hpp"
 #include <iostream>
 #include <chrono>
-#include <type_traits>
+#include <time.h>
 
 #define WITH_CMSIS_NN 1
 #define ARM_MATH_DSP 1
@@ -12,91 +12,255 @@
 extern bool save_output_csv;
 extern bool save_output_dac;
 
-template <typename T>
-void sample_norm(T (&data)[MODEL_INPUT_DIM_0][MODEL_INPUT_DIM_1])
+/* Optional batched entry point; a model built with it runs a whole backlog through each layer's weights at once. */
+extern "C" void cnn_batch(const input_t *const inputs[], output_t *const outputs[], int batch) __attribute__((weak));
+
+/* Optional streaming entry point for overlapping windows: hop is how far the window slid since the previous call
+   (0 when the previous window is not its predecessor), so the first layers only compute the new columns. */
+extern "C" void cnn_stream(const input_t input, uint32_t hop, output_t output) __attribute__((weak));
+
+/* Optional cheaper network run instead of cnn() on windows that would miss the latency budget (MODEL_SHED_FALLBACK). */
+extern "C" void cnn_fallback(const input_t input, output_t output) __attribute__((weak));
+
+/* Windows shed since the last published result, reported downstream as one gap. */
+struct shed_gap_t
 {
-    using base_t = typename std::remove_cv<typename std::remove_reference<decltype(data[0][0])>::type>::type;
+    uint64_t samples = 0;
+    uint64_t time_ns = 0;
+};
 
-    base_t min_val = data[0][0];
-    base_t max_val = data[0][0];
+static uint64_t monotonic_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static void publish_result(Channel &channel, const model_result_t &result)
+{
+    if (channel.result_ring.reader_count() == 0)
+        return;
 
-    for (size_t i = 1; i < MODEL_INPUT_DIM_0; ++i)
+    model_result_t *slot = channel.result_ring.claim();
+    if (!slot)
     {
-        if (data[i][0] < min_val)
-            min_val = data[i][0];
-        if (data[i][0] > max_val)
-            max_val = data[i][0];
+        channel.counters->ring_full_count.fetch_add(1, std::memory_order_relaxed);
+        if (channel.result_ring.slowest_reader() == channel.result_csv_reader)
+            channel.counters->result_drop_csv.fetch_add(1, std::memory_order_relaxed);
+        else
+            channel.counters->result_drop_dac.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
+    *slot = result;
+    channel.result_ring.publish();
+}
+
+static void forward_gap(Channel &channel, const data_part_t &marker)
+{
+    model_result_t result{};
+    result.gap_samples = marker.gap_samples;
+    result.gap_time_ns = marker.gap_time_ns;
+    publish_result(channel, result);
+}
 
-    base_t range = max_val - min_val;
-    if (range == 0)
-        range = 1;
+static void flush_shed_gap(Channel &channel, shed_gap_t &shed)
+{
+    if (!shed.samples)
+        return;
 
-    for (size_t i = 0; i < MODEL_INPUT_DIM_0; ++i)
+    data_part_t marker;
+    marker.gap_samples = shed.samples;
+    marker.gap_time_ns = shed.time_ns;
+    forward_gap(channel, marker);
+    shed = shed_gap_t{};
+}
+
+static void shed_window(Channel &channel, shed_gap_t &shed, const data_part_t &part)
+{
+    if (!shed.samples)
     {
-        if constexpr (std::is_floating_point<base_t>::value)
-        {
-            data[i][0] = static_cast<base_t>((data[i][0] - min_val) / static_cast<float>(range));
-        }
-        else
-        {
-            data[i][0] = static_cast<base_t>(((data[i][0] - min_val) * 512) / range);
-        }
+        uint64_t trigger_ns = channel.counters->trigger_time_ns.load(std::memory_order_relaxed);
+        shed.time_ns = part.acq_time_ns > trigger_ns ? part.acq_time_ns - trigger_ns : 0;
     }
+    shed.samples += MODEL_HOP_SIZE;
+    channel.counters->shed_count.fetch_add(1, std::memory_order_relaxed);
 }
 
-void model_inference(Channel &channel)
+/*
+ * Output latency the window would reach if it ran now: its queue age plus the expected model time.
+ * The estimate only counts while other windows wait behind it; shedding the last queued window
+ * cannot help the model catch up, so that one is judged by its age alone.
+ */
+static bool over_budget(const data_part_t &part, uint64_t now_ns, double avg_ms, bool backlog)
 {
-    try
+    double age_us = now_ns > part.acq_time_ns ? (now_ns - part.acq_time_ns) / 1000.0 : 0.0;
+    return age_us + (backlog ? avg_ms * 1000.0 : 0.0) > MODEL_LATENCY_BUDGET_US;
+}
+
+static void record_latency(Channel &channel, const data_part_t &part, uint64_t now_ns)
+{
+    uint64_t latency_us = now_ns > part.acq_time_ns ? (now_ns - part.acq_time_ns) / 1000 : 0;
+    channel.counters->output_latency_total_us.fetch_add(latency_us, std::memory_order_relaxed);
+    if (latency_us > channel.counters->output_latency_max_us.load(std::memory_order_relaxed))
+        channel.counters->output_latency_max_us.store(latency_us, std::memory_order_relaxed);
+}
+
+/* Backlog windows behind the head part that can join its batch without delaying its result by more than MODEL_BATCH_LATENCY_US. */
+static int gather_batch(Channel &channel, const data_part_t *parts[], double avg_ms)
+{
+    int count = 1;
+
+    while (count < MODEL_BATCH_MAX && count * avg_ms <= MODEL_BATCH_LATENCY_US / 1000.0)
+    {
+        const data_part_t *next = channel.model_ring.peek(count);
+        if (!next || next->gap_samples)
+            break;
+        parts[count++] = next;
+    }
+    return count;
+}
+
+static void run_inference(Channel &channel, bool normalize)
+{
+    const data_part_t *parts[MODEL_BATCH_MAX];
+    const input_t *inputs[MODEL_BATCH_MAX];
+    output_t *outputs[MODEL_BATCH_MAX];
+    input_t normalized[MODEL_BATCH_MAX];
+    model_result_t results[MODEL_BATCH_MAX];
+    double avg_ms = 0.0;
+    shed_gap_t shed;
+    uint32_t decimate_phase = 0;
+    uint32_t late_streak = 0;
+    bool stream_continues = true;
+
+#if PROFILE_LAYERS
+    layer_profile_attach(&channel.counters->layer_profile);
+#endif
+
+    while (true)
     {
-        while (true)
+        if (!channel.model_ring.wait(&channel.model_sem))
         {
-            if (sem_wait(&channel.model_sem) != 0)
+            if (stop_program.load())
+                break;
+            continue;
+        }
+
+        if (stop_program.load() && channel.model_ring.empty())
+            break;
+
+        while ((parts[0] = channel.model_ring.peek()) != nullptr)
+        {
+            if (parts[0]->gap_samples)
             {
-                if (errno == EINTR && stop_program.load())
-                    break;
+                flush_shed_gap(channel, shed);
+                forward_gap(channel, *parts[0]);
+                channel.model_ring.consume();
                 continue;
             }
 
-            if (stop_program.load() && channel.model_queue.empty())
-                break;
-
-            while (!channel.model_queue.empty())
+            /* After MODEL_SHED_PROBE_N windows in a row without cnn(), the next one runs it so avg_ms follows the model again. */
+            bool late = MODEL_SHED_POLICY != MODEL_SHED_NONE && late_streak < MODEL_SHED_PROBE_N &&
+                        over_budget(*parts[0], monotonic_ns(), avg_ms, channel.model_ring.peek(1) != nullptr);
+            bool fallback = late && MODEL_SHED_POLICY == MODEL_SHED_FALLBACK && cnn_fallback;
+            if (late && !fallback && (MODEL_SHED_POLICY != MODEL_SHED_DECIMATE || ++decimate_phase % MODEL_SHED_DECIMATE_K != 0))
             {
-                std::shared_ptr<data_part_t> part = channel.model_queue.front();
-                channel.model_queue.pop();
+                shed_window(channel, shed, *parts[0]);
+                channel.model_ring.consume();
+                stream_continues = false;
+                late_streak++;
+                continue;
+            }
+            flush_shed_gap(channel, shed);
 
-                model_result_t result;
-                auto start = std::chrono::high_resolution_clock::now();
-                cnn(part->data, result.output);
-                auto end = std::chrono::high_resolution_clock::now();
-                result.computation_time = std::chrono::duration<double, std::milli>(end - start).count();
+            /* Only a model with cnn_batch() gains from a batch; plain cnn() takes the head window alone so its result is not held back. */
+            int count = cnn_batch && !cnn_stream && !late ? gather_batch(channel, parts, avg_ms) : 1;
 
-                if (save_output_csv)
+            for (int i = 0; i < count; ++i)
+            {
+                if (normalize)
                 {
-                    channel.result_buffer_csv.push_back(result);
-                    sem_post(&channel.result_sem_csv);
+                    normalize_window(parts[i]->data, normalized[i], MODEL_INPUT_DIM_0);
+                    inputs[i] = &normalized[i];
                 }
-
-                if (save_output_dac)
+                else
                 {
-                    channel.result_buffer_dac.push_back(result);
-                    sem_post(&channel.result_sem_dac);
+                    inputs[i] = &parts[i]->data;
                 }
+                outputs[i] = &results[i].output;
+                results[i].seq = parts[i]->seq;
+                results[i].acq_time_ns = parts[i]->acq_time_ns;
+            }
 
-                channel.counters->model_count.fetch_add(1, std::memory_order_relaxed);
+            auto start = std::chrono::high_resolution_clock::now();
+            if (fallback)
+            {
+                cnn_fallback(*inputs[0], *outputs[0]);
+                auto end = std::chrono::high_resolution_clock::now();
+                results[0].computation_time = std::chrono::duration<double, std::milli>(end - start).count();
+                channel.counters->fallback_count.fetch_add(1, std::memory_order_relaxed);
+                stream_continues = false;
+                late_streak++;
+            }
+            else if (cnn_stream)
+            {
+                /* Per-window normalisation breaks the shift between consecutive inputs, so every call starts over. */
+                cnn_stream(*inputs[0], normalize || !stream_continues ? 0 : parts[0]->hop, *outputs[0]);
+                auto end = std::chrono::high_resolution_clock::now();
+                results[0].computation_time = std::chrono::duration<double, std::milli>(end - start).count();
+                stream_continues = true;
+            }
+            else if (cnn_batch)
+            {
+                cnn_batch(inputs, outputs, count);
+                auto end = std::chrono::high_resolution_clock::now();
+                double per_window = std::chrono::duration<double, std::milli>(end - start).count() / count;
+                for (int i = 0; i < count; ++i)
+                    results[i].computation_time = per_window;
+            }
+            else
+            {
+                cnn(*inputs[0], *outputs[0]);
+                auto end = std::chrono::high_resolution_clock::now();
+                results[0].computation_time = std::chrono::duration<double, std::milli>(end - start).count();
             }
 
-            if (channel.acquisition_done && channel.model_queue.empty())
-                break;
+            uint64_t done_ns = monotonic_ns();
+            for (int i = 0; i < count; ++i)
+            {
+                record_latency(channel, *parts[i], done_ns);
+                publish_result(channel, results[i]);
+                if (!fallback)
+                    avg_ms = avg_ms ? 0.875 * avg_ms + 0.125 * results[i].computation_time : results[i].computation_time;
+            }
+            if (!fallback)
+                late_streak = 0;
+            channel.model_ring.consume(count);
+
+            channel.counters->model_count.fetch_add(count, std::memory_order_relaxed);
+            if (count > 1)
+            {
+                channel.counters->batch_count.fetch_add(1, std::memory_order_relaxed);
+                channel.counters->batched_windows.fetch_add(count, std::memory_order_relaxed);
+                if (count > channel.counters->max_batch.load(std::memory_order_relaxed))
+                    channel.counters->max_batch.store(count, std::memory_order_relaxed);
+            }
         }
 
-        channel.processing_done = true;
-        if (save_output_csv)
-            sem_post(&channel.result_sem_csv);
-        if (save_output_dac)
-            sem_post(&channel.result_sem_dac);
+        if (channel.acquisition_done && channel.model_ring.empty())
+            break;
+    }
+
+    flush_shed_gap(channel, shed);
+    channel.processing_done = true;
+    channel.result_ring.wake_all();
+}
 
+void model_inference(Channel &channel)
+{
+    try
+    {
+        run_inference(channel, false);
         std::cout << "Model inference thread on channel " << static_cast<int>(channel.channel_id) + 1 << " exiting..." << std::endl;
     }
     catch (const std::exception &e)
@@ -109,56 +273,7 @@ void model_inference_mod(Channel &channel)
 {
     try
     {
-        while (true)
-        {
-            if (sem_wait(&channel.model_sem) != 0)
-            {
-                if (errno == EINTR && stop_program.load())
-                    break;
-                continue;
-            }
-
-            if (stop_program.load() && channel.model_queue.empty())
-                break;
-
-            while (!channel.model_queue.empty())
-            {
-                std::shared_ptr<data_part_t> part = channel.model_queue.front();
-                channel.model_queue.pop();
-
-                sample_norm(part->data); 
-
-                model_result_t result;
-                auto start = std::chrono::high_resolution_clock::now();
-                cnn(part->data, result.output);
-                auto end = std::chrono::high_resolution_clock::now();
-                result.computation_time = std::chrono::duration<double, std::milli>(end - start).count();
-
-                if (save_output_csv)
-                {
-                    channel.result_buffer_csv.push_back(result);
-                    sem_post(&channel.result_sem_csv);
-                }
-
-                if (save_output_dac)
-                {
-                    channel.result_buffer_dac.push_back(result);
-                    sem_post(&channel.result_sem_dac);
-                }
-
-                channel.counters->model_count.fetch_add(1, std::memory_order_relaxed);
-            }
-
-            if (channel.acquisition_done && channel.model_queue.empty())
-                break;
-        }
-
-        channel.processing_done = true;
-        if (save_output_csv)
-            sem_post(&channel.result_sem_csv);
-        if (save_output_dac)
-            sem_post(&channel.result_sem_dac);
-
+        run_inference(channel, true);
         std::cout << "Model inference mod thread on channel " << static_cast<int>(channel.channel_id) + 1 << " exiting..." << std::endl;
     }
     catch (const std::exception &e)
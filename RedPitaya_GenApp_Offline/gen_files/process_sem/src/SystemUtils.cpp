@@ -1,16 +1,22 @@
 /*SystemUtils.cpp*/
 
 #include "SystemUtils.hpp"
+#include "SegmentedWriter.hpp"
 #include <iostream>
 #include <csignal>
 #include <thread>
 #include <iomanip>
 #include <filesystem>
 #include <sys/statvfs.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
 
 volatile std::sig_atomic_t interrupted = 0;
+std::atomic<bool> disk_space_low(false);
 
-bool is_disk_space_below_threshold(const char *path, double threshold)
+bool get_available_disk_space(const char *path, double &available)
 {
     struct statvfs stat;
     if (statvfs(path, &stat) != 0)
@@ -19,10 +25,76 @@ bool is_disk_space_below_threshold(const char *path, double threshold)
         return false;
     }
 
-    double available_space = stat.f_bsize * stat.f_bavail;
+    available = static_cast<double>(stat.f_bsize) * stat.f_bavail;
+    return true;
+}
+
+bool is_disk_space_below_threshold(const char *path, double threshold)
+{
+    double available_space = 0;
+    if (!get_available_disk_space(path, available_space))
+        return false;
     return available_space < threshold;
 }
 
+/*
+ * Samples free space every interval_ms and raises disk_space_low once it is
+ * below threshold, or will be before the next sample at the current write rate.
+ * With WRITER_RETENTION it deletes the oldest closed segments instead, and only
+ * stops acquisition when there is none left.
+ * Runs at a low nice level so the SCHED_FIFO threads only ever read the flag.
+ */
+void disk_space_monitor(const char *path, double threshold, int interval_ms)
+{
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+
+    double previous = 0;
+    if (!get_available_disk_space(path, previous))
+        return;
+
+    auto previous_time = std::chrono::steady_clock::now();
+    double rate = 0;
+
+    while (!stop_acquisition.load())
+    {
+        double seconds_to_full = rate > 0 ? (previous - threshold) / rate : -1;
+        bool projected = seconds_to_full >= 0 && seconds_to_full * 1000.0 < interval_ms;
+        if (previous < threshold || projected)
+        {
+            if (WRITER_RETENTION && delete_oldest_segment())
+            {
+                get_available_disk_space(path, previous);
+                previous_time = std::chrono::steady_clock::now();
+                continue;
+            }
+
+            if (projected)
+                std::cerr << "WARN: Disk projected to reach threshold in " << seconds_to_full << " s at "
+                          << rate / (1024.0 * 1024.0) << " MB/s." << std::endl;
+            disk_space_low.store(true);
+            break;
+        }
+
+        for (int waited = 0; waited < interval_ms && !stop_acquisition.load(); waited += 50)
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::min(50, interval_ms - waited)));
+
+        double available = 0;
+        if (!get_available_disk_space(path, available))
+            continue;
+
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - previous_time).count();
+        if (elapsed > 0)
+        {
+            double instant_rate = std::max(0.0, (previous - available) / elapsed);
+            rate = rate > 0 ? 0.7 * rate + 0.3 * instant_rate : instant_rate;
+        }
+
+        previous = available;
+        previous_time = now;
+    }
+}
+
 void set_process_affinity(int core_id)
 {
     cpu_set_t cpuset;
@@ -74,12 +146,14 @@ void signal_handler(int sig)
 
         std::cin.setstate(std::ios::failbit);
         sem_post(&channel1.data_sem_csv);
+        sem_post(&channel1.data_sem_bin);
         sem_post(&channel1.data_sem_dac);
         sem_post(&channel1.model_sem);
         sem_post(&channel1.result_sem_csv);
         sem_post(&channel1.result_sem_dac);
 
         sem_post(&channel2.data_sem_csv);
+        sem_post(&channel2.data_sem_bin);
         sem_post(&channel2.data_sem_dac);
         sem_post(&channel2.model_sem);
         sem_post(&channel2.result_sem_csv);
@@ -100,50 +174,116 @@ void print_duration(const std::string &label, uint64_t start_ns, uint64_t end_ns
               << minutes << " min " << seconds << " sec " << ms << " ms\n";
 }
 
-void print_channel_stats(const shared_counters_t *counters)
+/* The statistics of one channel; ch is its number as printed. */
+static void print_one_channel(const shared_counters_t &counters, int ch)
 {
-    std::cout << "\n====================================\n\n";
-
-    print_duration("Channel 1", counters[0].trigger_time_ns.load(), counters[0].end_time_ns.load());
-    print_duration("Channel 2", counters[1].trigger_time_ns.load(), counters[1].end_time_ns.load());
+    const std::string name = "CH" + std::to_string(ch);
 
-    std::cout << std::left << std::setw(60) << "Total data acquired CH1:" << counters[0].acquire_count.load() << '\n';
+    std::cout << std::left << std::setw(60) << "Total data acquired " + name + ":" << counters.acquire_count.load() << '\n';
+    if (counters.overrun_count.load() > 0)
+    {
+        std::cout << std::left << std::setw(60) << "Overruns recovered " + name + " (lost samples):" << counters.overrun_count.load()
+                  << " (" << counters.lost_samples.load() << ")\n";
+    }
+    if (counters.drain_count.load() > 0)
+    {
+        std::cout << std::left << std::setw(60) << "Chunks per drain " + name + " (avg / max):" << std::fixed << std::setprecision(2)
+                  << static_cast<double>(counters.drained_chunks.load()) / counters.drain_count.load()
+                  << " / " << counters.max_chunks_per_drain.load() << std::defaultfloat << '\n';
+    }
+    if (counters.wake_count.load() > 0)
+    {
+        std::cout << std::left << std::setw(60) << "Poll wake-up jitter " + name + " (avg / max us):" << std::fixed << std::setprecision(1)
+                  << counters.wake_jitter_total_ns.load() / 1000.0 / counters.wake_count.load()
+                  << " / " << counters.wake_jitter_max_ns.load() / 1000.0 << std::defaultfloat << '\n';
+    }
     if (save_data_csv)
     {
-        std::cout << std::left << std::setw(60) << "Total lines written CH1 to csv:" << counters[0].write_count_csv.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Total lines written " + name + " to csv:" << counters.write_count_csv.load() << '\n';
+    }
+    if (save_data_bin)
+    {
+        std::cout << std::left << std::setw(60) << "Total windows written " + name + " to binary capture:" << counters.write_count_bin.load() << '\n';
+    }
+    if (counters.segments_opened.load() > 0)
+    {
+        std::cout << std::left << std::setw(60) << "File segments " + name + " (opened / deleted):" << counters.segments_opened.load()
+                  << " / " << counters.segments_deleted.load() << '\n';
+    }
+    if (counters.compress_bytes.load() > 0)
+    {
+        std::cout << std::left << std::setw(60) << "Capture compression " + name + " (ratio / us per window):" << std::fixed << std::setprecision(2)
+                  << static_cast<double>(counters.compress_raw_bytes.load()) / counters.compress_bytes.load()
+                  << " / " << counters.compress_total_ns.load() / 1000.0 / counters.write_count_bin.load() << std::defaultfloat << '\n';
     }
     if (save_data_dac)
     {
-        std::cout << std::left << std::setw(60) << "Total lines written CH1 to DAC_CH1:" << counters[0].write_count_dac.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Total lines written " + name + " to DAC_" + name + ":" << counters.write_count_dac.load() << '\n';
+    }
+    std::cout << std::left << std::setw(60) << "Total model calculated " + name + ":" << counters.model_count.load() << '\n';
+    if (counters.batch_count.load() > 0)
+    {
+        std::cout << std::left << std::setw(60) << "Inference batches " + name + " (count / avg / max size):" << counters.batch_count.load()
+                  << " / " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(counters.batched_windows.load()) / counters.batch_count.load()
+                  << " / " << counters.max_batch.load() << std::defaultfloat << '\n';
+    }
+    if (counters.shed_count.load() > 0 || counters.fallback_count.load() > 0)
+    {
+        std::cout << std::left << std::setw(60) << "Windows shed " + name + " (skipped / fallback model):" << counters.shed_count.load()
+                  << " / " << counters.fallback_count.load() << '\n';
+    }
+    if (counters.model_count.load() > 0)
+    {
+        std::cout << std::left << std::setw(60) << "Output latency " + name + " (avg / max ms):" << std::fixed << std::setprecision(2)
+                  << counters.output_latency_total_us.load() / 1000.0 / counters.model_count.load()
+                  << " / " << counters.output_latency_max_us.load() / 1000.0 << std::defaultfloat << '\n';
     }
-    std::cout << std::left << std::setw(60) << "Total model calculated CH1:" << counters[0].model_count.load() << '\n';
     if (save_output_csv)
     {
-        std::cout << std::left << std::setw(60) << "Total results logged CH1 to csv file:" << counters[0].log_count_csv.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Total results logged " + name + " to csv file:" << counters.log_count_csv.load() << '\n';
     }
     if (save_output_dac)
     {
-        std::cout << std::left << std::setw(60) << "Total results written to DAC_CH1:" << counters[0].log_count_dac.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Total results written to DAC_" + name + ":" << counters.log_count_dac.load() << '\n';
     }
-
-    std::cout << std::left << std::setw(60) << "Total data acquired CH2:" << counters[1].acquire_count.load() << '\n';
-    if (save_data_csv)
+    if (counters.model_queue_full_count.load() > 0)
     {
-        std::cout << std::left << std::setw(60) << "Total lines written CH2 to csv:" << counters[1].write_count_csv.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Windows dropped on full model queue " + name + ":" << counters.model_queue_full_count.load() << '\n';
     }
-    if (save_data_dac)
+    if (counters.sink_slot_full_count.load() > 0)
     {
-        std::cout << std::left << std::setw(60) << "Total lines written CH2 to DAC_CH1:" << counters[1].write_count_dac.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Windows dropped for the sinks, no free slot " + name + ":" << counters.sink_slot_full_count.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Sink drops " + name + " by slowest sink (csv / bin / dac):" << counters.data_drop_csv.load()
+                  << " / " << counters.data_drop_bin.load() << " / " << counters.data_drop_dac.load() << '\n';
     }
-    std::cout << std::left << std::setw(60) << "Total model calculated CH2:" << counters[1].model_count.load() << '\n';
-    if (save_output_csv)
+    if (counters.ring_full_count.load() > 0)
     {
-        std::cout << std::left << std::setw(60) << "Total results logged CH2 to csv file:" << counters[1].log_count_csv.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Results dropped on full result ring " + name + ":" << counters.ring_full_count.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Result drops " + name + " by slowest sink (csv / dac):" << counters.result_drop_csv.load()
+                  << " / " << counters.result_drop_dac.load() << '\n';
     }
-    if (save_output_dac)
+    if (counters.writer_flushes.load() > 0)
     {
-        std::cout << std::left << std::setw(60) << "Total results written to DAC_CH2:" << counters[1].log_count_dac.load() << '\n';
+        double seconds = (counters.end_time_ns.load() - counters.trigger_time_ns.load()) / 1e9;
+        std::cout << std::left << std::setw(60) << "File writes " + name + " (MB/s / flushes / fsyncs):" << std::fixed << std::setprecision(3)
+                  << (seconds > 0 ? counters.writer_bytes.load() / 1e6 / seconds : 0.0)
+                  << " / " << counters.writer_flushes.load() << " / " << counters.writer_fsyncs.load() << std::defaultfloat << '\n';
+        std::cout << std::left << std::setw(60) << "File flush latency " + name + " (avg / max ms):" << std::fixed << std::setprecision(2)
+                  << counters.writer_flush_total_us.load() / 1000.0 / counters.writer_flushes.load()
+                  << " / " << counters.writer_flush_max_us.load() / 1000.0 << std::defaultfloat << '\n';
     }
+}
+
+void print_channel_stats(const shared_counters_t *counters)
+{
+    std::cout << "\n====================================\n\n";
+
+    print_duration("Channel 1", counters[0].trigger_time_ns.load(), counters[0].end_time_ns.load());
+    print_duration("Channel 2", counters[1].trigger_time_ns.load(), counters[1].end_time_ns.load());
+
+    print_one_channel(counters[0], 1);
+    print_one_channel(counters[1], 2);
 
     std::cout << "\n====================================\n";
 }
@@ -160,6 +300,9 @@ void folder_manager(const std::string &folder_path)
         {
             for (const auto &entry : fs::directory_iterator(dir_path))
             {
+                if (WRITER_SEGMENTED && is_segment_file(entry.path()))
+                    continue;
+
                 try
                 {
                     fs::remove_all(entry);
@@ -184,7 +327,7 @@ void folder_manager(const std::string &folder_path)
     }
 }
 
-bool ask_user_preferences(bool &save_data_csv, bool &save_data_dac, bool &save_output_csv, bool &save_output_dac)
+bool ask_user_preferences(bool &save_data_csv, bool &save_data_bin, bool &save_data_dac, bool &save_output_csv, bool &save_output_dac)
 {
     int max_attempts = 3;
 
@@ -196,18 +339,23 @@ bool ask_user_preferences(bool &save_data_csv, bool &save_data_dac, bool &save_o
                   << " 2. To DAC only\n"
                   << " 3. Both CSV and DAC\n"
                   << " 4. None\n"
-                  << "Enter your choice (1-4): ";
+                  << " 5. As binary capture only\n"
+                  << " 6. Both binary capture and DAC\n"
+                  << " 7. Both CSV and binary capture\n"
+                  << " 8. CSV, binary capture and DAC\n"
+                  << "Enter your choice (1-8): ";
         std::cin >> save_choice;
 
-        if (save_choice >= 1 && save_choice <= 4)
+        if (save_choice >= 1 && save_choice <= 8)
         {
-            save_data_csv = (save_choice == 1 || save_choice == 3);
-            save_data_dac = (save_choice == 2 || save_choice == 3);
+            save_data_csv = (save_choice == 1 || save_choice == 3 || save_choice == 7 || save_choice == 8);
+            save_data_bin = (save_choice == 5 || save_choice == 6 || save_choice == 7 || save_choice == 8);
+            save_data_dac = (save_choice == 2 || save_choice == 3 || save_choice == 6 || save_choice == 8);
             break;
         }
         else
         {
-            std::cerr << "Invalid input. Please enter a number between 1 and 4.\n";
+            std::cerr << "Invalid input. Please enter a number between 1 and 8.\n";
             if (attempt == max_attempts)
                 return false;
         }
@@ -18,15 +18,18 @@
 #include "SystemUtils.hpp"
 #include "DataAcquisition.hpp"
 #include "DataWriterCSV.hpp"
+#include "DataWriterBin.hpp"
 #include "DataWriterDAC.hpp"
 #include "ModelProcessing.hpp"
 #include "ModelWriterCSV.hpp"
 #include "ModelWriterDAC.hpp"
 #include "DAC.hpp"
+#include "LayerProfile.hpp"
 
 pid_t pid1 = -1;
 pid_t pid2 = -1;
 bool save_data_csv = false;
+bool save_data_bin = false;
 bool save_data_dac = false;
 bool save_output_csv = false;
 bool save_output_dac = false;
@@ -40,12 +43,14 @@ int main()
     }
 
     sem_init(&channel1.data_sem_csv, 0, 0);
+    sem_init(&channel1.data_sem_bin, 0, 0);
     sem_init(&channel1.data_sem_dac, 0, 0);
     sem_init(&channel1.model_sem, 0, 0);
     sem_init(&channel1.result_sem_csv, 0, 0);
     sem_init(&channel1.result_sem_dac, 0, 0);
 
     sem_init(&channel2.data_sem_csv, 0, 0);
+    sem_init(&channel2.data_sem_bin, 0, 0);
     sem_init(&channel2.data_sem_dac, 0, 0);
     sem_init(&channel2.model_sem, 0, 0);
     sem_init(&channel2.result_sem_csv, 0, 0);
@@ -79,28 +84,97 @@ int main()
     new (&shared_counters[0].acquire_count) std::atomic<int>(0);
     new (&shared_counters[0].model_count) std::atomic<int>(0);
     new (&shared_counters[0].write_count_csv) std::atomic<int>(0);
+    new (&shared_counters[0].write_count_bin) std::atomic<int>(0);
     new (&shared_counters[0].write_count_dac) std::atomic<int>(0);
     new (&shared_counters[0].log_count_csv) std::atomic<int>(0);
     new (&shared_counters[0].log_count_dac) std::atomic<int>(0);
+    new (&shared_counters[0].ring_full_count) std::atomic<int>(0);
+    new (&shared_counters[0].model_queue_full_count) std::atomic<int>(0);
+    new (&shared_counters[0].sink_slot_full_count) std::atomic<int>(0);
+    new (&shared_counters[0].data_drop_csv) std::atomic<int>(0);
+    new (&shared_counters[0].data_drop_bin) std::atomic<int>(0);
+    new (&shared_counters[0].data_drop_dac) std::atomic<int>(0);
+    new (&shared_counters[0].result_drop_csv) std::atomic<int>(0);
+    new (&shared_counters[0].result_drop_dac) std::atomic<int>(0);
+    new (&shared_counters[0].drain_count) std::atomic<int>(0);
+    new (&shared_counters[0].drained_chunks) std::atomic<int>(0);
+    new (&shared_counters[0].max_chunks_per_drain) std::atomic<int>(0);
+    new (&shared_counters[0].wake_count) std::atomic<int>(0);
+    new (&shared_counters[0].overrun_count) std::atomic<int>(0);
+    new (&shared_counters[0].batch_count) std::atomic<int>(0);
+    new (&shared_counters[0].batched_windows) std::atomic<int>(0);
+    new (&shared_counters[0].max_batch) std::atomic<int>(0);
+    new (&shared_counters[0].shed_count) std::atomic<int>(0);
+    new (&shared_counters[0].fallback_count) std::atomic<int>(0);
+    new (&shared_counters[0].output_latency_total_us) std::atomic<uint64_t>(0);
+    new (&shared_counters[0].output_latency_max_us) std::atomic<uint64_t>(0);
+    new (&shared_counters[0].lost_samples) std::atomic<uint64_t>(0);
+    new (&shared_counters[0].writer_bytes) std::atomic<uint64_t>(0);
+    new (&shared_counters[0].writer_flushes) std::atomic<int>(0);
+    new (&shared_counters[0].writer_fsyncs) std::atomic<int>(0);
+    new (&shared_counters[0].writer_flush_total_us) std::atomic<uint64_t>(0);
+    new (&shared_counters[0].writer_flush_max_us) std::atomic<uint64_t>(0);
+    new (&shared_counters[0].segments_opened) std::atomic<int>(0);
+    new (&shared_counters[0].segments_deleted) std::atomic<int>(0);
+    new (&shared_counters[0].compress_raw_bytes) std::atomic<uint64_t>(0);
+    new (&shared_counters[0].compress_bytes) std::atomic<uint64_t>(0);
+    new (&shared_counters[0].compress_total_ns) std::atomic<uint64_t>(0);
+    new (&shared_counters[0].wake_jitter_total_ns) std::atomic<uint64_t>(0);
+    new (&shared_counters[0].wake_jitter_max_ns) std::atomic<uint64_t>(0);
 
     new (&shared_counters[1].acquire_count) std::atomic<int>(0);
     new (&shared_counters[1].model_count) std::atomic<int>(0);
     new (&shared_counters[1].write_count_csv) std::atomic<int>(0);
+    new (&shared_counters[1].write_count_bin) std::atomic<int>(0);
     new (&shared_counters[1].write_count_dac) std::atomic<int>(0);
     new (&shared_counters[1].log_count_csv) std::atomic<int>(0);
     new (&shared_counters[1].log_count_dac) std::atomic<int>(0);
+    new (&shared_counters[1].ring_full_count) std::atomic<int>(0);
+    new (&shared_counters[1].model_queue_full_count) std::atomic<int>(0);
+    new (&shared_counters[1].sink_slot_full_count) std::atomic<int>(0);
+    new (&shared_counters[1].data_drop_csv) std::atomic<int>(0);
+    new (&shared_counters[1].data_drop_bin) std::atomic<int>(0);
+    new (&shared_counters[1].data_drop_dac) std::atomic<int>(0);
+    new (&shared_counters[1].result_drop_csv) std::atomic<int>(0);
+    new (&shared_counters[1].result_drop_dac) std::atomic<int>(0);
+    new (&shared_counters[1].drain_count) std::atomic<int>(0);
+    new (&shared_counters[1].drained_chunks) std::atomic<int>(0);
+    new (&shared_counters[1].max_chunks_per_drain) std::atomic<int>(0);
+    new (&shared_counters[1].wake_count) std::atomic<int>(0);
+    new (&shared_counters[1].overrun_count) std::atomic<int>(0);
+    new (&shared_counters[1].batch_count) std::atomic<int>(0);
+    new (&shared_counters[1].batched_windows) std::atomic<int>(0);
+    new (&shared_counters[1].max_batch) std::atomic<int>(0);
+    new (&shared_counters[1].shed_count) std::atomic<int>(0);
+    new (&shared_counters[1].fallback_count) std::atomic<int>(0);
+    new (&shared_counters[1].output_latency_total_us) std::atomic<uint64_t>(0);
+    new (&shared_counters[1].output_latency_max_us) std::atomic<uint64_t>(0);
+    new (&shared_counters[1].lost_samples) std::atomic<uint64_t>(0);
+    new (&shared_counters[1].writer_bytes) std::atomic<uint64_t>(0);
+    new (&shared_counters[1].writer_flushes) std::atomic<int>(0);
+    new (&shared_counters[1].writer_fsyncs) std::atomic<int>(0);
+    new (&shared_counters[1].writer_flush_total_us) std::atomic<uint64_t>(0);
+    new (&shared_counters[1].writer_flush_max_us) std::atomic<uint64_t>(0);
+    new (&shared_counters[1].segments_opened) std::atomic<int>(0);
+    new (&shared_counters[1].segments_deleted) std::atomic<int>(0);
+    new (&shared_counters[1].compress_raw_bytes) std::atomic<uint64_t>(0);
+    new (&shared_counters[1].compress_bytes) std::atomic<uint64_t>(0);
+    new (&shared_counters[1].compress_total_ns) std::atomic<uint64_t>(0);
+    new (&shared_counters[1].wake_jitter_total_ns) std::atomic<uint64_t>(0);
+    new (&shared_counters[1].wake_jitter_max_ns) std::atomic<uint64_t>(0);
 
     new (&shared_counters[0].ready_barrier) std::atomic<int>(0);
     new (&shared_counters[1].ready_barrier) std::atomic<int>(0);
 
     std::cout << "Starting program" << std::endl;
 
-    if (!ask_user_preferences(save_data_csv, save_data_dac, save_output_csv, save_output_dac))
+    if (!ask_user_preferences(save_data_csv, save_data_bin, save_data_dac, save_output_csv, save_output_dac))
     {
         std::cerr << "User input failed. Exiting." << std::endl;
         return -1;
     }
     ::save_data_csv = save_data_csv;
+    ::save_data_bin = save_data_bin;
     ::save_data_dac = save_data_dac;
     ::save_output_csv = save_output_csv;
     ::save_output_dac = save_output_dac;
@@ -131,14 +205,19 @@ int main()
         channel1.counters = &shared_counters_ch1[0];
         set_process_affinity(0);
 
+        register_channel_sinks(channel1);
+
         wait_for_barrier(shared_counters_ch1[0].ready_barrier, 2);
+        std::thread disk_thread(disk_space_monitor, "/", DISK_SPACE_THRESHOLD, DISK_MONITOR_INTERVAL_MS);
         std::thread acq_thread(acquire_data, std::ref(channel1), RP_CH_1);
         std::thread model_thread(model_inference, std::ref(channel1));
 
-        std::thread write_thread_csv, write_thread_dac, log_thread_csv, log_thread_dac;
+        std::thread write_thread_csv, write_thread_bin, write_thread_dac, log_thread_csv, log_thread_dac;
 
         if (save_data_csv)
             write_thread_csv = std::thread(write_data_csv, std::ref(channel1), "DataOutput/data_ch1.csv");
+        if (save_data_bin)
+            write_thread_bin = std::thread(write_data_bin, std::ref(channel1), "DataOutput/data_ch1.bin");
         if (save_data_dac)
             write_thread_dac = std::thread(write_data_dac, std::ref(channel1), RP_CH_1);
 
@@ -156,10 +235,14 @@ int main()
 
         if (acq_thread.joinable())
             acq_thread.join();
+        if (disk_thread.joinable())
+            disk_thread.join();
         if (model_thread.joinable())
             model_thread.join();
         if (save_data_csv && write_thread_csv.joinable())
             write_thread_csv.join();
+        if (save_data_bin && write_thread_bin.joinable())
+            write_thread_bin.join();
         if (save_data_dac && write_thread_dac.joinable())
             write_thread_dac.join();
         if (save_output_csv && log_thread_csv.joinable())
@@ -194,14 +277,19 @@ int main()
         channel2.counters = &shared_counters_ch2[1];
         set_process_affinity(1);
 
+        register_channel_sinks(channel2);
+
         wait_for_barrier(shared_counters_ch2[0].ready_barrier, 2);
+        std::thread disk_thread(disk_space_monitor, "/", DISK_SPACE_THRESHOLD, DISK_MONITOR_INTERVAL_MS);
         std::thread acq_thread(acquire_data, std::ref(channel2), RP_CH_2);
         std::thread model_thread(model_inference, std::ref(channel2));
 
-        std::thread write_thread_csv, write_thread_dac, log_thread_csv, log_thread_dac;
+        std::thread write_thread_csv, write_thread_bin, write_thread_dac, log_thread_csv, log_thread_dac;
 
         if (save_data_csv)
             write_thread_csv = std::thread(write_data_csv, std::ref(channel2), "DataOutput/data_ch2.csv");
+        if (save_data_bin)
+            write_thread_bin = std::thread(write_data_bin, std::ref(channel2), "DataOutput/data_ch2.bin");
         if (save_data_dac)
             write_thread_dac = std::thread(write_data_dac, std::ref(channel2), RP_CH_2);
 
@@ -219,10 +307,14 @@ int main()
 
         if (acq_thread.joinable())
             acq_thread.join();
+        if (disk_thread.joinable())
+            disk_thread.join();
         if (model_thread.joinable())
             model_thread.join();
         if (save_data_csv && write_thread_csv.joinable())
             write_thread_csv.join();
+        if (save_data_bin && write_thread_bin.joinable())
+            write_thread_bin.join();
         if (save_data_dac && write_thread_dac.joinable())
             write_thread_dac.join();
         if (save_output_csv && log_thread_csv.joinable())
@@ -242,15 +334,18 @@ int main()
 
     cleanup();
     print_channel_stats(shared_counters);
+    print_layer_profile(shared_counters);
     shm_unlink(SHM_COUNTERS);
 
     sem_destroy(&channel1.data_sem_csv);
+    sem_destroy(&channel1.data_sem_bin);
     sem_destroy(&channel1.data_sem_dac);
     sem_destroy(&channel1.model_sem);
     sem_destroy(&channel1.result_sem_csv);
     sem_destroy(&channel1.result_sem_dac);
 
     sem_destroy(&channel2.data_sem_csv);
+    sem_destroy(&channel2.data_sem_bin);
     sem_destroy(&channel2.data_sem_dac);
     sem_destroy(&channel2.model_sem);
     sem_destroy(&channel2.result_sem_csv);
@@ -0,0 +1,97 @@
+/*RiceCodecTest.cpp*/
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "RiceCodec.hpp"
+
+#define TEST_WINDOWS 2000
+
+static size_t total_escaped = 0;
+
+/* Windows that take the escape path: a quotient of RICE_ESCAPE or more under the chosen k. */
+template <typename T, size_t Count>
+static bool uses_escape(const T (&window)[Count][1], const uint8_t *payload)
+{
+    int32_t previous = 0;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        if ((rice_zigzag(static_cast<int32_t>(window[i][0]) - previous) >> payload[0]) >= RICE_ESCAPE)
+            return true;
+        previous = window[i][0];
+    }
+    return false;
+}
+
+/*
+ * rice_encode then rice_decode must give the window back exactly, within
+ * RICE_MAX_BYTES, and a payload cut short by one byte must be rejected.
+ */
+template <typename T, size_t Count, typename Fill>
+static bool round_trip(const std::string &name, Fill fill)
+{
+    static T window[Count][1], decoded[Count][1];
+    static uint8_t payload[RICE_MAX_BYTES(Count)];
+    size_t mismatches = 0, truncated_accepted = 0, escaped = 0, bytes = 0;
+
+    for (int w = 0; w < TEST_WINDOWS; ++w)
+    {
+        for (size_t i = 0; i < Count; ++i)
+            window[i][0] = fill(w, i);
+
+        size_t size = rice_encode(window, payload);
+        bytes += size;
+        escaped += uses_escape(window, payload);
+
+        if (size > RICE_MAX_BYTES(Count) || !rice_decode(payload, size, decoded))
+        {
+            mismatches++;
+            continue;
+        }
+        for (size_t i = 0; i < Count; ++i)
+            mismatches += decoded[i][0] != window[i][0];
+
+        truncated_accepted += rice_decode(payload, size - 1, decoded);
+    }
+
+    total_escaped += escaped;
+    double ratio = static_cast<double>(TEST_WINDOWS) * Count * sizeof(T) / bytes;
+    std::cout << name << ": " << mismatches << " mismatches, " << escaped << " windows escaped, "
+              << truncated_accepted << " truncated payloads accepted, ratio " << ratio << "\n";
+    return mismatches == 0 && truncated_accepted == 0;
+}
+
+int main()
+{
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int> code(-8192, 8191);
+    std::uniform_int_distribution<int> full(-32768, 32767);
+    std::uniform_int_distribution<int> noise(-3, 3);
+    std::uniform_int_distribution<int> byte(-128, 127);
+
+    bool ok = true;
+    ok &= round_trip<int16_t, 128>("int16 sine + noise", [&](int w, size_t i) {
+        return static_cast<int16_t>(std::lround(6000.0 * std::sin(0.05 * (w * 128 + i))) + noise(rng));
+    });
+    ok &= round_trip<int16_t, 128>("int16 ADC-range noise", [&](int, size_t) { return static_cast<int16_t>(code(rng)); });
+    ok &= round_trip<int16_t, 128>("int16 full-range noise", [&](int, size_t) { return static_cast<int16_t>(full(rng)); });
+    ok &= round_trip<int16_t, 128>("int16 flat with spikes", [&](int w, size_t i) {
+        return static_cast<int16_t>(i % 37 == static_cast<size_t>(w % 37) ? full(rng) : noise(rng));
+    });
+    ok &= round_trip<int16_t, 128>("int16 extremes", [&](int w, size_t i) {
+        return static_cast<int16_t>((i + w) % 2 ? 32767 : -32768);
+    });
+    ok &= round_trip<int16_t, 64>("int16 zeros", [](int, size_t) { return static_cast<int16_t>(0); });
+    ok &= round_trip<int8_t, 128>("int8 noise", [&](int, size_t) { return static_cast<int8_t>(byte(rng)); });
+    ok &= round_trip<int8_t, 128>("int8 flat with spikes", [&](int w, size_t i) {
+        return static_cast<int8_t>(i == static_cast<size_t>(w % 128) ? (w % 2 ? 127 : -128) : 0);
+    });
+
+    ok &= total_escaped > 0;
+
+    std::cout << (ok ? "OK" : "FAIL") << ": Rice round trip, " << total_escaped << " windows through the escape path\n";
+    return ok ? 0 : 1;
+}
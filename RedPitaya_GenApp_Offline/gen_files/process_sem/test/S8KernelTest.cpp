@@ -0,0 +1,319 @@
+/*S8KernelTest.cpp*/
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "arm_nnfunctions.h"
+
+/*
+ * Naive references written after the TensorFlow Lite Micro reference kernels
+ * (integer conv, fully connected, average/max pool), against which the s8 and
+ * q7/q15 CMSIS-NN kernels must agree bit for bit.
+ */
+
+static int32_t ref_doubling_high_mul(int32_t a, int32_t b)
+{
+    if (a == b && a == std::numeric_limits<int32_t>::min())
+        return std::numeric_limits<int32_t>::max();
+    const int64_t ab = static_cast<int64_t>(a) * b;
+    const int64_t nudge = ab >= 0 ? (1LL << 30) : (1 - (1LL << 30));
+    return static_cast<int32_t>((ab + nudge) / (1LL << 31));
+}
+
+static int32_t ref_rounding_divide_by_pot(int32_t x, int exponent)
+{
+    const int32_t mask = static_cast<int32_t>((1LL << exponent) - 1);
+    const int32_t remainder = x & mask;
+    const int32_t threshold = (mask >> 1) + (x < 0 ? 1 : 0);
+    return (x >> exponent) + (remainder > threshold ? 1 : 0);
+}
+
+/* TFLite MultiplyByQuantizedMultiplier. */
+static int32_t ref_requantize(int32_t x, int32_t multiplier, int shift)
+{
+    const int left_shift = shift > 0 ? shift : 0;
+    const int right_shift = shift > 0 ? 0 : -shift;
+    return ref_rounding_divide_by_pot(ref_doubling_high_mul(x * (1 << left_shift), multiplier), right_shift);
+}
+
+static int8_t ref_output(int32_t acc, int32_t multiplier, int shift, int32_t out_offset, int32_t act_min, int32_t act_max)
+{
+    acc = ref_requantize(acc, multiplier, shift) + out_offset;
+    return static_cast<int8_t>(std::min(std::max(acc, act_min), act_max));
+}
+
+struct conv_case_t
+{
+    int32_t batches, in_x, in_y, ch_in, ch_out;
+    int32_t kernel_x, kernel_y, pad_x, pad_y, stride_x, stride_y, dilation_x, dilation_y;
+    int32_t input_offset, output_offset, act_min, act_max;
+};
+
+struct fc_case_t
+{
+    int32_t batches, accum_depth, output_depth;
+    int32_t input_offset, output_offset, act_min, act_max, shift;
+};
+
+struct pool_case_t
+{
+    int32_t in_x, in_y, ch, kernel_x, kernel_y, pad_x, pad_y, stride_x, stride_y;
+    int32_t act_min, act_max;
+};
+
+static std::mt19937 rng(31337);
+
+static int32_t random_int(int32_t low, int32_t high)
+{
+    return std::uniform_int_distribution<int32_t>(low, high)(rng);
+}
+
+static std::vector<int8_t> random_s8(size_t count)
+{
+    std::vector<int8_t> values(count);
+    for (int8_t &v : values)
+        v = static_cast<int8_t>(random_int(-128, 127));
+    return values;
+}
+
+static size_t count_mismatches(const std::vector<int8_t> &got, const std::vector<int8_t> &want)
+{
+    size_t mismatches = 0;
+    for (size_t i = 0; i < got.size(); ++i)
+        mismatches += got[i] != want[i];
+    return mismatches;
+}
+
+static size_t run_conv_case(const conv_case_t &c)
+{
+    const int32_t out_x = (c.in_x + 2 * c.pad_x - c.dilation_x * (c.kernel_x - 1) - 1) / c.stride_x + 1;
+    const int32_t out_y = (c.in_y + 2 * c.pad_y - c.dilation_y * (c.kernel_y - 1) - 1) / c.stride_y + 1;
+
+    std::vector<int8_t> input = random_s8(static_cast<size_t>(c.batches) * c.in_y * c.in_x * c.ch_in);
+    std::vector<int8_t> filter = random_s8(static_cast<size_t>(c.ch_out) * c.kernel_y * c.kernel_x * c.ch_in);
+    std::vector<int32_t> bias(c.ch_out), multiplier(c.ch_out), shift(c.ch_out);
+    for (int32_t oc = 0; oc < c.ch_out; ++oc)
+    {
+        bias[oc] = random_int(-20000, 20000);
+        multiplier[oc] = random_int(1 << 30, std::numeric_limits<int32_t>::max());
+        shift[oc] = random_int(-11, -6);
+    }
+
+    std::vector<int8_t> want(static_cast<size_t>(c.batches) * out_y * out_x * c.ch_out);
+    size_t idx = 0;
+    for (int32_t b = 0; b < c.batches; ++b)
+        for (int32_t oy = 0; oy < out_y; ++oy)
+            for (int32_t ox = 0; ox < out_x; ++ox)
+                for (int32_t oc = 0; oc < c.ch_out; ++oc)
+                {
+                    int32_t acc = 0;
+                    for (int32_t ky = 0; ky < c.kernel_y; ++ky)
+                        for (int32_t kx = 0; kx < c.kernel_x; ++kx)
+                        {
+                            const int32_t iy = oy * c.stride_y - c.pad_y + ky * c.dilation_y;
+                            const int32_t ix = ox * c.stride_x - c.pad_x + kx * c.dilation_x;
+                            if (iy < 0 || iy >= c.in_y || ix < 0 || ix >= c.in_x)
+                                continue;
+                            for (int32_t ic = 0; ic < c.ch_in; ++ic)
+                            {
+                                const int32_t in = input[((b * c.in_y + iy) * c.in_x + ix) * c.ch_in + ic];
+                                const int32_t wt = filter[((oc * c.kernel_y + ky) * c.kernel_x + kx) * c.ch_in + ic];
+                                acc += wt * (in + c.input_offset);
+                            }
+                        }
+                    acc += bias[oc];
+                    want[idx++] = ref_output(acc, multiplier[oc], shift[oc], c.output_offset, c.act_min, c.act_max);
+                }
+
+    cmsis_nn_conv_params conv_params = {c.input_offset, c.output_offset, {c.stride_x, c.stride_y}, {c.pad_x, c.pad_y},
+                                        {c.dilation_x, c.dilation_y}, {c.act_min, c.act_max}};
+    cmsis_nn_per_channel_quant_params quant_params = {multiplier.data(), shift.data()};
+    cmsis_nn_dims input_dims = {c.batches, c.in_y, c.in_x, c.ch_in};
+    cmsis_nn_dims filter_dims = {c.ch_out, c.kernel_y, c.kernel_x, c.ch_in};
+    cmsis_nn_dims bias_dims = {1, 1, 1, c.ch_out};
+    cmsis_nn_dims output_dims = {c.batches, out_y, out_x, c.ch_out};
+    std::vector<int8_t> buffer(arm_convolve_s8_get_buffer_size(&input_dims, &filter_dims));
+    cmsis_nn_context ctx = {buffer.data(), static_cast<int32_t>(buffer.size())};
+
+    std::vector<int8_t> got(want.size());
+    if (arm_convolve_s8(&ctx, &conv_params, &quant_params, &input_dims, input.data(), &filter_dims, filter.data(),
+                        &bias_dims, bias.data(), &output_dims, got.data()) != ARM_MATH_SUCCESS)
+        return want.size();
+    return count_mismatches(got, want);
+}
+
+static size_t run_fc_case(const fc_case_t &c)
+{
+    std::vector<int8_t> input = random_s8(static_cast<size_t>(c.batches) * c.accum_depth);
+    std::vector<int8_t> weights = random_s8(static_cast<size_t>(c.output_depth) * c.accum_depth);
+    std::vector<int32_t> bias(c.output_depth);
+    for (int32_t &b : bias)
+        b = random_int(-20000, 20000);
+    const int32_t multiplier = random_int(1 << 30, std::numeric_limits<int32_t>::max());
+
+    std::vector<int8_t> want(static_cast<size_t>(c.batches) * c.output_depth);
+    for (int32_t b = 0; b < c.batches; ++b)
+        for (int32_t o = 0; o < c.output_depth; ++o)
+        {
+            int32_t acc = 0;
+            for (int32_t d = 0; d < c.accum_depth; ++d)
+                acc += weights[o * c.accum_depth + d] * (input[b * c.accum_depth + d] + c.input_offset);
+            acc += bias[o];
+            want[b * c.output_depth + o] = ref_output(acc, multiplier, c.shift, c.output_offset, c.act_min, c.act_max);
+        }
+
+    cmsis_nn_fc_params fc_params = {c.input_offset, 0, c.output_offset, {c.act_min, c.act_max}};
+    cmsis_nn_per_tensor_quant_params quant_params = {multiplier, c.shift};
+    cmsis_nn_dims input_dims = {c.batches, 1, 1, c.accum_depth};
+    cmsis_nn_dims filter_dims = {c.accum_depth, 1, 1, c.output_depth};
+    cmsis_nn_dims bias_dims = {1, 1, 1, c.output_depth};
+    cmsis_nn_dims output_dims = {c.batches, 1, 1, c.output_depth};
+    cmsis_nn_context ctx = {nullptr, 0};
+
+    std::vector<int8_t> got(want.size());
+    if (arm_fully_connected_s8(&ctx, &fc_params, &quant_params, &input_dims, input.data(), &filter_dims, weights.data(),
+                               &bias_dims, bias.data(), &output_dims, got.data()) != ARM_MATH_SUCCESS)
+        return want.size();
+    return count_mismatches(got, want);
+}
+
+/* Average pool when average is set, max pool otherwise; padded positions are left out of both. */
+static size_t run_pool_case(const pool_case_t &c, bool average)
+{
+    const int32_t out_x = (c.in_x + 2 * c.pad_x - c.kernel_x) / c.stride_x + 1;
+    const int32_t out_y = (c.in_y + 2 * c.pad_y - c.kernel_y) / c.stride_y + 1;
+    std::vector<int8_t> input = random_s8(static_cast<size_t>(c.in_y) * c.in_x * c.ch);
+
+    std::vector<int8_t> want(static_cast<size_t>(out_y) * out_x * c.ch);
+    for (int32_t oy = 0; oy < out_y; ++oy)
+        for (int32_t ox = 0; ox < out_x; ++ox)
+            for (int32_t ch = 0; ch < c.ch; ++ch)
+            {
+                int32_t acc = average ? 0 : -128;
+                int32_t count = 0;
+                for (int32_t ky = 0; ky < c.kernel_y; ++ky)
+                    for (int32_t kx = 0; kx < c.kernel_x; ++kx)
+                    {
+                        const int32_t iy = oy * c.stride_y - c.pad_y + ky;
+                        const int32_t ix = ox * c.stride_x - c.pad_x + kx;
+                        if (iy < 0 || iy >= c.in_y || ix < 0 || ix >= c.in_x)
+                            continue;
+                        const int32_t in = input[(iy * c.in_x + ix) * c.ch + ch];
+                        acc = average ? acc + in : std::max(acc, in);
+                        count++;
+                    }
+                if (average)
+                    acc = acc > 0 ? (acc + count / 2) / count : (acc - count / 2) / count;
+                want[(oy * out_x + ox) * c.ch + ch] = static_cast<int8_t>(std::min(std::max(acc, c.act_min), c.act_max));
+            }
+
+    cmsis_nn_pool_params pool_params = {{c.stride_x, c.stride_y}, {c.pad_x, c.pad_y}, {c.act_min, c.act_max}};
+    cmsis_nn_dims input_dims = {1, c.in_y, c.in_x, c.ch};
+    cmsis_nn_dims filter_dims = {1, c.kernel_y, c.kernel_x, 1};
+    cmsis_nn_dims output_dims = {1, out_y, out_x, c.ch};
+    cmsis_nn_context ctx = {nullptr, 0};
+
+    std::vector<int8_t> got(want.size());
+    arm_status status = average
+                            ? arm_avgpool_s8(&ctx, &pool_params, &input_dims, input.data(), &filter_dims, &output_dims, got.data())
+                            : arm_max_pool_s8(&ctx, &pool_params, &input_dims, input.data(), &filter_dims, &output_dims, got.data());
+    if (status != ARM_MATH_SUCCESS)
+        return want.size();
+    return count_mismatches(got, want);
+}
+
+/* relu6_s8, relu_q7 and relu_q15 in place, on lengths around the 16-lane NEON loop. */
+static size_t run_relu_case(uint16_t size)
+{
+    size_t mismatches = 0;
+
+    std::vector<int8_t> s8 = random_s8(size), s8_want(size);
+    std::transform(s8.begin(), s8.end(), s8_want.begin(), [](int8_t v) { return static_cast<int8_t>(std::min(std::max<int>(v, 0), 6)); });
+    arm_relu6_s8(s8.data(), size);
+    mismatches += count_mismatches(s8, s8_want);
+
+    std::vector<int8_t> q7 = random_s8(size), q7_want(size);
+    std::transform(q7.begin(), q7.end(), q7_want.begin(), [](int8_t v) { return static_cast<int8_t>(std::max<int>(v, 0)); });
+    arm_relu_q7(q7.data(), size);
+    mismatches += count_mismatches(q7, q7_want);
+
+    std::vector<q15_t> q15(size);
+    for (q15_t &v : q15)
+        v = static_cast<q15_t>(random_int(-32768, 32767));
+    std::vector<q15_t> q15_want(q15);
+    for (q15_t &v : q15_want)
+        v = std::max<q15_t>(v, 0);
+    arm_relu_q15(q15.data(), size);
+    for (size_t i = 0; i < q15.size(); ++i)
+        mismatches += q15[i] != q15_want[i];
+
+    return mismatches;
+}
+
+int main()
+{
+    const conv_case_t conv_cases[] = {
+        /* n, in_x, in_y, ch_in, ch_out, k_x, k_y, pad_x, pad_y, s_x, s_y, d_x, d_y, in_off, out_off, act_min, act_max */
+        {1, 128, 1, 1, 8, 3, 1, 0, 0, 1, 1, 1, 1, 0, 0, -128, 127},
+        {1, 128, 1, 1, 8, 5, 1, 2, 0, 1, 1, 1, 1, 128, -128, -128, 127},
+        {2, 64, 1, 3, 6, 7, 1, 3, 0, 2, 1, 1, 1, 17, 5, -128, 127},
+        {1, 64, 1, 4, 5, 3, 1, 2, 0, 1, 1, 2, 1, -33, -7, -128, 127},
+        {1, 100, 1, 2, 4, 4, 1, 3, 0, 3, 1, 3, 1, 1, 12, -20, 90},
+        {1, 16, 12, 3, 5, 3, 3, 1, 1, 1, 2, 1, 2, -127, 3, -128, 127},
+        {2, 9, 9, 19, 3, 3, 3, 1, 1, 2, 2, 1, 1, 64, -64, 0, 127},
+    };
+    const fc_case_t fc_cases[] = {
+        /* n, accum_depth, output_depth, in_off, out_off, act_min, act_max, shift */
+        {1, 128, 2, 0, 0, -128, 127, -8},
+        {3, 64, 10, 128, -128, -128, 127, -9},
+        {2, 33, 7, -5, 20, -128, 127, -7},
+        {1, 7, 3, 40, 0, 0, 127, 1},
+        {4, 200, 16, -128, 9, -50, 50, -10},
+    };
+    const pool_case_t pool_cases[] = {
+        /* in_x, in_y, ch, k_x, k_y, pad_x, pad_y, s_x, s_y, act_min, act_max */
+        {128, 1, 1, 2, 1, 0, 0, 2, 1, -128, 127},
+        {64, 1, 8, 3, 1, 1, 0, 2, 1, -128, 127},
+        {33, 1, 19, 4, 1, 2, 0, 3, 1, -100, 100},
+        {12, 10, 16, 3, 3, 1, 1, 1, 1, -128, 127},
+        {7, 7, 33, 2, 2, 1, 1, 2, 2, 0, 127},
+    };
+    const uint16_t relu_sizes[] = {1, 15, 16, 17, 128, 255};
+
+    size_t failed = 0;
+    size_t total = 0;
+    auto report = [&](const std::string &name, size_t mismatches) {
+        std::cout << name << ": " << mismatches << " mismatches\n";
+        failed += mismatches != 0;
+        total++;
+    };
+
+    for (const conv_case_t &c : conv_cases)
+        report("conv_s8 in " + std::to_string(c.in_x) + "x" + std::to_string(c.in_y) + "x" + std::to_string(c.ch_in) +
+                   " kernel " + std::to_string(c.kernel_x) + "x" + std::to_string(c.kernel_y) + " pad " +
+                   std::to_string(c.pad_x) + " stride " + std::to_string(c.stride_x) + " dilation " +
+                   std::to_string(c.dilation_x) + "x" + std::to_string(c.dilation_y) + " offsets " +
+                   std::to_string(c.input_offset) + "/" + std::to_string(c.output_offset),
+               run_conv_case(c));
+    for (const fc_case_t &c : fc_cases)
+        report("fully_connected_s8 " + std::to_string(c.accum_depth) + " -> " + std::to_string(c.output_depth) +
+                   " batch " + std::to_string(c.batches) + " shift " + std::to_string(c.shift),
+               run_fc_case(c));
+    for (const pool_case_t &c : pool_cases)
+    {
+        const std::string shape = std::to_string(c.in_x) + "x" + std::to_string(c.in_y) + "x" + std::to_string(c.ch) +
+                                  " kernel " + std::to_string(c.kernel_x) + "x" + std::to_string(c.kernel_y) +
+                                  " pad " + std::to_string(c.pad_x);
+        report("avgpool_s8 " + shape, run_pool_case(c, true));
+        report("max_pool_s8 " + shape, run_pool_case(c, false));
+    }
+    for (uint16_t size : relu_sizes)
+        report("relu6_s8 / relu_q7 / relu_q15 size " + std::to_string(size), run_relu_case(size));
+
+    std::cout << (failed ? "FAIL" : "OK") << ": s8/q7 kernels vs reference, " << total << " cases\n";
+    return failed ? 1 : 0;
+}
@@ -31,6 +31,9 @@
 #include "arm_nnfunctions.h"
 #include "arm_nnsupportfunctions.h"
 
+/* Built once as its own object; model.c #includes this file and skips it with -DARM_NN_KERNELS_EXTERNAL */
+#ifndef ARM_NN_KERNELS_EXTERNAL
+
 /**
  *  @ingroup groupNN
  */
@@ -76,7 +79,7 @@
  * dimension.
  */
 
-arm_status arm_convolve_HWC_q15_basic_nonsquare(const q15_t *Im_in,
+arm_status (arm_convolve_HWC_q15_basic_nonsquare)(const q15_t *Im_in,
                                       const uint16_t dim_im_in_x,
                                       const uint16_t dim_im_in_y,
                                       const uint16_t ch_im_in,
@@ -98,8 +101,8 @@ arm_status arm_convolve_HWC_q15_basic_nonsquare(const q15_t *Im_in,
                                       q7_t *bufferB)
 {
     (void)bufferB;
-#if defined(ARM_MATH_DSP) && !defined(ARM_MATH_MVEI)
-    /* Run the following code for Cortex-M4 and Cortex-M7 */
+#if defined(ARM_MATH_NEON) || (defined(ARM_MATH_DSP) && !defined(ARM_MATH_MVEI))
+    /* Run the following code for Cortex-M4 and Cortex-M7, and Cortex-A with NEON */
 
     int16_t i_out_y, i_out_x, i_ker_y, i_ker_x;
 
@@ -141,6 +144,11 @@ arm_status arm_convolve_HWC_q15_basic_nonsquare(const q15_t *Im_in,
             for (i = 0; i < ch_im_out; i++)
             {
                 q31_t sum = ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift);
+#if defined(ARM_MATH_NEON)
+                const int32_t colLen = ch_im_in * dim_kernel_y * dim_kernel_x;
+                sum = arm_nn_dot_q15_neon(pA, im_buffer, colLen, sum);
+                pA += colLen;
+#else
                 const q15_t *pB = im_buffer;
                 uint16_t colCnt = ch_im_in * dim_kernel_y * dim_kernel_x >> 2;
                 while (colCnt)
@@ -163,6 +171,7 @@ arm_status arm_convolve_HWC_q15_basic_nonsquare(const q15_t *Im_in,
                     sum += inA1 * inB1;
                     colCnt--;
                 }
+#endif
                 *pOut = (q15_t)__SSAT((sum >> out_shift), 16);
                 pOut++;
             }
@@ -214,6 +223,163 @@ arm_status arm_convolve_HWC_q15_basic_nonsquare(const q15_t *Im_in,
     return ARM_MATH_SUCCESS;
 }
 
+arm_status (arm_convolve_HWC_q15_basic_nonsquare_batch)(const q15_t *Im_in,
+                                                      const uint16_t dim_im_in_x,
+                                                      const uint16_t dim_im_in_y,
+                                                      const uint16_t ch_im_in,
+                                                      const q15_t *wt,
+                                                      const uint16_t ch_im_out,
+                                                      const uint16_t dim_kernel_x,
+                                                      const uint16_t dim_kernel_y,
+                                                      const uint16_t padding_x,
+                                                      const uint16_t padding_y,
+                                                      const uint16_t stride_x,
+                                                      const uint16_t stride_y,
+                                                      const q15_t *bias,
+                                                      const uint16_t bias_shift,
+                                                      const uint16_t out_shift,
+                                                      q15_t *Im_out,
+                                                      const uint16_t dim_im_out_x,
+                                                      const uint16_t dim_im_out_y,
+                                                      q15_t *bufferA,
+                                                      const uint16_t batch)
+{
+    const int32_t col_len = ch_im_in * dim_kernel_y * dim_kernel_x;
+    const int32_t im_in_size = dim_im_in_x * dim_im_in_y * ch_im_in;
+    const int32_t im_out_size = dim_im_out_x * dim_im_out_y * ch_im_out;
+    int16_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int b, i;
+
+    for (i_out_y = 0; i_out_y < dim_im_out_y; i_out_y++)
+    {
+        for (i_out_x = 0; i_out_x < dim_im_out_x; i_out_x++)
+        {
+            /* im2col of this output pixel for every image of the batch */
+            q15_t *pBuffer = bufferA;
+            for (b = 0; b < batch; b++)
+            {
+                const q15_t *pIm = Im_in + b * im_in_size;
+                for (i_ker_y = i_out_y * stride_y - padding_y; i_ker_y < i_out_y * stride_y - padding_y + dim_kernel_y; i_ker_y++)
+                {
+                    for (i_ker_x = i_out_x * stride_x - padding_x; i_ker_x < i_out_x * stride_x - padding_x + dim_kernel_x; i_ker_x++)
+                    {
+                        if (i_ker_y < 0 || i_ker_y >= dim_im_in_y || i_ker_x < 0 || i_ker_x >= dim_im_in_x)
+                        {
+                            memset(pBuffer, 0, sizeof(q15_t) * ch_im_in);
+                        }
+                        else
+                        {
+                            memcpy(pBuffer, pIm + (i_ker_y * dim_im_in_x + i_ker_x) * ch_im_in, sizeof(q15_t) * ch_im_in);
+                        }
+                        pBuffer += ch_im_in;
+                    }
+                }
+            }
+
+            const q15_t *pA = wt;
+            q15_t *pOut = Im_out + (i_out_y * dim_im_out_x + i_out_x) * ch_im_out;
+            for (i = 0; i < ch_im_out; i++)
+            {
+                const q31_t init = ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift);
+                for (b = 0; b < batch; b++)
+                {
+                    q31_t sum = arm_nn_dot_q15(pA, bufferA + b * col_len, col_len, init);
+                    pOut[b * im_out_size + i] = (q15_t)__SSAT((sum >> out_shift), 16);
+                }
+                pA += col_len;
+            }
+        }
+    }
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @brief Basic Q15 convolution of a window that slid along x by shift_x input columns
+ *
+ * Im_out holds the output of the previous window and is updated in place. Output
+ * columns whose receptive field lay entirely inside the previous input (no padding)
+ * are moved down by shift_x / stride_x; only the columns that see new samples or
+ * padding are computed. A shift_x of 0, not a multiple of stride_x or not smaller
+ * than dim_im_in_x recomputes every column. Results are identical to
+ * arm_convolve_HWC_q15_basic_nonsquare on the new window.
+ */
+arm_status (arm_convolve_HWC_q15_basic_nonsquare_incremental)(const q15_t *Im_in,
+                                                            const uint16_t dim_im_in_x,
+                                                            const uint16_t dim_im_in_y,
+                                                            const uint16_t ch_im_in,
+                                                            const q15_t *wt,
+                                                            const uint16_t ch_im_out,
+                                                            const uint16_t dim_kernel_x,
+                                                            const uint16_t dim_kernel_y,
+                                                            const uint16_t padding_x,
+                                                            const uint16_t padding_y,
+                                                            const uint16_t stride_x,
+                                                            const uint16_t stride_y,
+                                                            const q15_t *bias,
+                                                            const uint16_t bias_shift,
+                                                            const uint16_t out_shift,
+                                                            q15_t *Im_out,
+                                                            const uint16_t dim_im_out_x,
+                                                            const uint16_t dim_im_out_y,
+                                                            q15_t *bufferA,
+                                                            const uint16_t shift_x)
+{
+    const int32_t col_len = ch_im_in * dim_kernel_y * dim_kernel_x;
+    const int incremental = shift_x > 0 && shift_x < dim_im_in_x && (shift_x % stride_x) == 0;
+    const int shift_out = incremental ? shift_x / stride_x : 0;
+    int16_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int i;
+
+    for (i_out_y = 0; i_out_y < dim_im_out_y; i_out_y++)
+    {
+        for (i_out_x = 0; i_out_x < dim_im_out_x; i_out_x++)
+        {
+            const int first_x = i_out_x * stride_x - padding_x;
+            q15_t *pOut = Im_out + (i_out_y * dim_im_out_x + i_out_x) * ch_im_out;
+
+            if (incremental && first_x >= 0 && first_x + dim_kernel_x + shift_x <= dim_im_in_x &&
+                i_out_x + shift_out < dim_im_out_x)
+            {
+                /* Same receptive field as a column of the previous output, which has not been overwritten yet */
+                memmove(pOut, pOut + shift_out * ch_im_out, sizeof(q15_t) * ch_im_out);
+                continue;
+            }
+
+            q15_t *pBuffer = bufferA;
+            for (i_ker_y = i_out_y * stride_y - padding_y; i_ker_y < i_out_y * stride_y - padding_y + dim_kernel_y; i_ker_y++)
+            {
+                for (i_ker_x = first_x; i_ker_x < first_x + dim_kernel_x; i_ker_x++)
+                {
+                    if (i_ker_y < 0 || i_ker_y >= dim_im_in_y || i_ker_x < 0 || i_ker_x >= dim_im_in_x)
+                    {
+                        memset(pBuffer, 0, sizeof(q15_t) * ch_im_in);
+                    }
+                    else
+                    {
+                        memcpy(pBuffer, Im_in + (i_ker_y * dim_im_in_x + i_ker_x) * ch_im_in, sizeof(q15_t) * ch_im_in);
+                    }
+                    pBuffer += ch_im_in;
+                }
+            }
+
+            const q15_t *pA = wt;
+            for (i = 0; i < ch_im_out; i++)
+            {
+                q31_t sum = arm_nn_dot_q15(pA, bufferA, col_len, ((q31_t)bias[i] << bias_shift) + NN_ROUND(out_shift));
+                pOut[i] = (q15_t)__SSAT((sum >> out_shift), 16);
+                pA += col_len;
+            }
+        }
+    }
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
 /**
  * @} end of NNConv group
  */
+
+#endif /* ARM_NN_KERNELS_EXTERNAL */
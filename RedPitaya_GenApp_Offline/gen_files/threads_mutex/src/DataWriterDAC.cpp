@@ -1,6 +1,7 @@
 /* DataWriterDAC.cpp */
 
 #include "DataWriterDAC.hpp"
+#include <algorithm>
 #include <iostream>
 #include <type_traits>
 
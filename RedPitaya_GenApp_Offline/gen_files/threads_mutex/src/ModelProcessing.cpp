@@ -66,7 +66,7 @@ void model_inference(Channel &channel)
 
             model_result_t result;
             auto start = std::chrono::high_resolution_clock::now();
-            cnn(part->data, result.output);
+            channel.model_ctx->run(part->data, result.output);
             auto end = std::chrono::high_resolution_clock::now();
             result.computation_time = std::chrono::duration<double, std::milli>(end - start).count();
 
@@ -133,7 +133,7 @@ void model_inference_mod(Channel &channel)
 
             model_result_t result;
             auto start = std::chrono::high_resolution_clock::now();
-            cnn(part->data, result.output);
+            channel.model_ctx->run(part->data, result.output);
             auto end = std::chrono::high_resolution_clock::now();
             result.computation_time = std::chrono::duration<double, std::milli>(end - start).count();
 
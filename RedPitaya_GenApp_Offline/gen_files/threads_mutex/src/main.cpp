@@ -52,6 +52,9 @@ int main()
 
     initialize_acq();
     initialize_DAC();
+
+    channel1.model_ctx = acquire_model_context();
+    channel2.model_ctx = acquire_model_context();
     std::thread acq_thread1(acquire_data, std::ref(channel1), RP_CH_1);
     std::thread acq_thread2(acquire_data, std::ref(channel2), RP_CH_2);
     std::thread model_thread1(model_inference, std::ref(channel1));
@@ -61,18 +64,26 @@ int main()
     std::thread write_thread_csv2, write_thread_dac2, log_thread_csv2, log_thread_dac2;
 
     if (save_data_csv)
+    {
         write_thread_csv1 = std::thread(write_data_csv, std::ref(channel1), "DataOutput/data_ch1.csv");
-    write_thread_csv2 = std::thread(write_data_csv, std::ref(channel2), "DataOutput/data_ch2.csv");
+        write_thread_csv2 = std::thread(write_data_csv, std::ref(channel2), "DataOutput/data_ch2.csv");
+    }
     if (save_data_dac)
+    {
         write_thread_dac1 = std::thread(write_data_dac, std::ref(channel1), RP_CH_1);
-    write_thread_dac2 = std::thread(write_data_dac, std::ref(channel2), RP_CH_2);
+        write_thread_dac2 = std::thread(write_data_dac, std::ref(channel2), RP_CH_2);
+    }
 
     if (save_output_csv)
+    {
         log_thread_csv1 = std::thread(log_results_csv, std::ref(channel1), "ModelOutput/output_ch1.csv");
-    log_thread_csv2 = std::thread(log_results_csv, std::ref(channel2), "ModelOutput/output_ch2.csv");
+        log_thread_csv2 = std::thread(log_results_csv, std::ref(channel2), "ModelOutput/output_ch2.csv");
+    }
     if (save_output_dac)
+    {
         log_thread_dac1 = std::thread(log_results_dac, std::ref(channel1), RP_CH_1);
-    log_thread_dac2 = std::thread(log_results_dac, std::ref(channel2), RP_CH_2);
+        log_thread_dac2 = std::thread(log_results_dac, std::ref(channel2), RP_CH_2);
+    }
 
     
     
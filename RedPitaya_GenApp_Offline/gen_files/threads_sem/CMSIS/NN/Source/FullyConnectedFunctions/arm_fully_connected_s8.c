@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2010-2022 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_fully_connected_s8.c
+ * Description:  Fully connected function compatible with TF Lite.
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M and Cortex-A (NEON) cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+/* Built once as its own object; model.c #includes this file and skips it with -DARM_NN_KERNELS_EXTERNAL */
+#ifndef ARM_NN_KERNELS_EXTERNAL
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup FC
+ * @{
+ */
+
+/*
+ * S8 basic fully-connected and matrix multiplication layer function for TensorFlow Lite
+ *
+ * Refer header file for details.
+ *
+ */
+
+arm_status (arm_fully_connected_s8)(const cmsis_nn_context *ctx,
+                                  const cmsis_nn_fc_params *fc_params,
+                                  const cmsis_nn_per_tensor_quant_params *quant_params,
+                                  const cmsis_nn_dims *input_dims,
+                                  const q7_t *input,
+                                  const cmsis_nn_dims *filter_dims,
+                                  const q7_t *kernel,
+                                  const cmsis_nn_dims *bias_dims,
+                                  const int32_t *bias,
+                                  const cmsis_nn_dims *output_dims,
+                                  q7_t *output)
+{
+    (void)ctx;
+    (void)bias_dims;
+
+    int32_t batch_cnt = input_dims->n;
+    const int32_t accum_depth = filter_dims->n;
+    const int32_t output_depth = output_dims->c;
+
+    const int32_t input_offset = fc_params->input_offset;
+    const int32_t out_offset = fc_params->output_offset;
+    const int32_t out_activation_min = fc_params->activation.min;
+    const int32_t out_activation_max = fc_params->activation.max;
+
+    while (batch_cnt)
+    {
+        const q7_t *pKernel = kernel;
+        for (int32_t i_out = 0; i_out < output_depth; i_out++)
+        {
+            int32_t sum = arm_nn_dot_s8(input, pKernel, accum_depth);
+            sum += input_offset * arm_nn_sum_s8(pKernel, accum_depth);
+            if (bias)
+            {
+                sum += bias[i_out];
+            }
+            sum = arm_nn_requantize(sum, quant_params->multiplier, quant_params->shift);
+            sum += out_offset;
+            sum = MAX(sum, out_activation_min);
+            sum = MIN(sum, out_activation_max);
+            *output++ = (q7_t)sum;
+
+            pKernel += accum_depth;
+        }
+        input += accum_depth;
+        batch_cnt--;
+    }
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+int32_t arm_fully_connected_s8_get_buffer_size(const cmsis_nn_dims *filter_dims)
+{
+    (void)filter_dims;
+    return 0;
+}
+
+/**
+ * @} end of FC group
+ */
+
+#endif /* ARM_NN_KERNELS_EXTERNAL */
@@ -8,12 +8,13 @@
 
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <csignal>
 #include <cstdint>
 #include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <semaphore.h>
 #include <string>
 #include <thread>
@@ -21,9 +22,15 @@
 
 #include "rp.h"
 #include "../model/include/model.h"
+#include "ModelContext.hpp"
+#include "SpscRing.hpp"
 
 #define DATA_SIZE 16384
 #define QUEUE_MAX_SIZE 1000000
+#define RING_CAPACITY 4096
+#ifndef DATA_RING_CAPACITY
+#define DATA_RING_CAPACITY 1024
+#endif
 #define DECIMATION (125000 / MODEL_INPUT_DIM_0)
 #define DISK_SPACE_THRESHOLD 0.2 * 1024 * 1024 * 1024
 #define acq_priority 1
@@ -53,12 +60,12 @@ struct model_result_t
 
 struct Channel
 {
-    std::queue<std::shared_ptr<data_part_t>> data_queue_csv;
-    std::queue<std::shared_ptr<data_part_t>> data_queue_dac;
-    std::queue<std::shared_ptr<data_part_t>> model_queue;
+    SpscRing<data_part_t, DATA_RING_CAPACITY> data_ring_csv;
+    SpscRing<data_part_t, DATA_RING_CAPACITY> data_ring_dac;
+    SpscRing<data_part_t, DATA_RING_CAPACITY> model_ring;
 
-    std::deque<model_result_t> result_buffer_csv;
-    std::deque<model_result_t> result_buffer_dac;
+    SpscRing<model_result_t, RING_CAPACITY> result_ring_csv;
+    SpscRing<model_result_t, RING_CAPACITY> result_ring_dac;
 
     sem_t data_sem_csv;
     sem_t data_sem_dac;
@@ -70,8 +77,8 @@ struct Channel
     std::chrono::steady_clock::time_point trigger_time_point;
     std::chrono::steady_clock::time_point end_time_point;
 
-    bool acquisition_done = false;
-    bool processing_done = false;
+    std::atomic<bool> acquisition_done{false};
+    std::atomic<bool> processing_done{false};
     bool channel_triggered = false;
 
     std::atomic<int> acquire_count{0};
@@ -80,11 +87,22 @@ struct Channel
     std::atomic<int> write_count_dac{0};
     std::atomic<int> log_count_csv{0};
     std::atomic<int> log_count_dac{0};
+    std::atomic<int> data_drop_csv{0};
+    std::atomic<int> data_drop_dac{0};
+    std::atomic<int> model_drop{0};
+    std::atomic<int> result_drop_csv{0};
+    std::atomic<int> result_drop_dac{0};
 
     std::atomic<uint64_t> trigger_time_ns{0};
     std::atomic<uint64_t> end_time_ns{0};
 
     rp_channel_t channel_id;
+    ModelContext *model_ctx = nullptr;
+
+    uint64_t window_seq = 0;
+    std::mutex reorder_mutex;
+    std::map<uint64_t, model_result_t> reorder_pending;
+    uint64_t reorder_next = 0;
 };
 
 extern std::atomic<bool> stop_acquisition;
@@ -92,6 +110,34 @@ extern std::atomic<bool> stop_program;
 
 extern Channel channel1, channel2;
 
+/* Producer side of a ring: counts the value as dropped when the consumer is a full ring behind. */
+template <typename T, size_t Capacity>
+inline void ring_push(SpscRing<T, Capacity> &ring, sem_t *sem, std::atomic<int> &drops, const T &value)
+{
+    T *slot = ring.claim();
+    if (!slot)
+    {
+        drops.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    *slot = value;
+    ring.publish();
+    ring.notify(sem);
+}
+
+/*
+ * Hands a result to the enabled output sinks. Each result ring has one producer at a time: the
+ * channel's model thread, or with INFERENCE_POOL the pool worker releasing under reorder_mutex.
+ */
+inline void publish_result(Channel &channel, const model_result_t &result)
+{
+    if (save_output_csv)
+        ring_push(channel.result_ring_csv, &channel.result_sem_csv, channel.result_drop_csv, result);
+    if (save_output_dac)
+        ring_push(channel.result_ring_dac, &channel.result_sem_dac, channel.result_drop_dac, result);
+    channel.model_count.fetch_add(1, std::memory_order_relaxed);
+}
+
 template <typename T>
 inline void convert_raw_data(const int16_t *src, T dst[MODEL_INPUT_DIM_0][1], size_t count)
 {
@@ -0,0 +1,110 @@
+/*SpscRing.hpp*/
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <semaphore.h>
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+/*
+ * Fixed-capacity single-producer/single-consumer ring with preallocated slots.
+ * The producer writes a slot in place (claim() then publish()), the consumer
+ * reads it in place (peek() then consume()). Producer and consumer indices live
+ * on separate cache lines and each side keeps a cached copy of the other's index,
+ * so a hand-off is one acquire load in the common case plus one release store.
+ * The semaphore is only touched when the consumer actually goes to sleep on an
+ * empty ring.
+ */
+template <typename T, size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    /* Producer side: the next free slot, or null when the consumer is Capacity slots behind. */
+    T *claim()
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == Capacity)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == Capacity)
+                return nullptr;
+        }
+        return &slots_[tail & (Capacity - 1)];
+    }
+
+    void publish()
+    {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /* Consumer side: the slot offset entries past the head, or null if not published yet. */
+    const T *peek(size_t offset = 0)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (cached_tail_ - head <= offset)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (cached_tail_ - head <= offset)
+                return nullptr;
+        }
+        return &slots_[(head + offset) & (Capacity - 1)];
+    }
+
+    void consume(size_t count = 1)
+    {
+        head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    /* Producer side, after publish(): posts only if the consumer announced it is sleeping. */
+    void notify(sem_t *sem)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed) && sleeping_.exchange(false, std::memory_order_acq_rel))
+            sem_post(sem);
+    }
+
+    /* Consumer side: blocks until notify() or an external sem_post. Returns false on EINTR. */
+    bool wait(sem_t *sem)
+    {
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!empty())
+        {
+            sleeping_.store(false, std::memory_order_relaxed);
+            return true;
+        }
+        int rc = sem_wait(sem);
+        sleeping_.store(false, std::memory_order_relaxed);
+        return rc == 0 || errno != EINTR;
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> sleeping_{false};
+
+    alignas(CACHE_LINE_SIZE) T slots_[Capacity];
+};
@@ -2,6 +2,7 @@
 
 #include "DataAcquisition.hpp"
 #include "SystemUtils.hpp"
+#include "InferencePool.hpp"
 #include <iostream>
 
 void acquire_data(Channel &channel, rp_channel_t rp_channel)
@@ -87,27 +88,24 @@ void acquire_data(Channel &channel, rp_channel_t rp_channel)
                         continue;
                     }
 
-                    auto part = std::make_shared<data_part_t>();
-                    convert_raw_data(buffer_raw, part->data, samples_per_chunk);
+                    data_part_t part;
+                    convert_raw_data(buffer_raw, part.data, samples_per_chunk);
 
                     pos += samples_per_chunk;
                     if (pos >= DATA_SIZE)
                         pos -= DATA_SIZE;
 
                     if (save_data_csv)
-                    {
-                        channel.data_queue_csv.push(part);
-                        sem_post(&channel.data_sem_csv);
-                    }
+                        ring_push(channel.data_ring_csv, &channel.data_sem_csv, channel.data_drop_csv, part);
 
                     if (save_data_dac)
-                    {
-                        channel.data_queue_dac.push(part);
-                        sem_post(&channel.data_sem_dac);
-                    }
+                        ring_push(channel.data_ring_dac, &channel.data_sem_dac, channel.data_drop_dac, part);
 
-                    channel.model_queue.push(part);
-                    sem_post(&channel.model_sem);
+#if INFERENCE_POOL
+                    inference_pool_submit(channel, std::make_shared<data_part_t>(part));
+#else
+                    ring_push(channel.model_ring, &channel.model_sem, channel.model_drop, part);
+#endif
 
                     channel.acquire_count.fetch_add(1, std::memory_order_relaxed);
                 }
@@ -120,7 +118,7 @@ void acquire_data(Channel &channel, rp_channel_t rp_channel)
                 channel.end_time_point.time_since_epoch())
                 .count());
 
-        channel.acquisition_done = true;
+        channel.acquisition_done.store(true);
 
         if (save_data_csv)
             sem_post(&channel.data_sem_csv);
@@ -128,7 +126,11 @@ void acquire_data(Channel &channel, rp_channel_t rp_channel)
         if (save_data_dac)
             sem_post(&channel.data_sem_dac);
 
+#if INFERENCE_POOL
+        inference_pool_close(channel);
+#else
         sem_post(&channel.model_sem);
+#endif
 
         std::cout << "Acquisition thread on channel " << static_cast<int>(channel.channel_id) + 1 << " exiting..." << std::endl;
     }
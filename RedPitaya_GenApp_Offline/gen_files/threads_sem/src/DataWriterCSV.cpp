@@ -33,20 +33,19 @@ void write_data_csv(Channel &channel, const std::string &filename)
             return;
         }
 
+        const data_part_t *part = nullptr;
+
         while (true)
         {
-            if (sem_wait(&channel.data_sem_csv) != 0)
+            if (!channel.data_ring_csv.wait(&channel.data_sem_csv))
             {
-                if (errno == EINTR && stop_program.load())
+                if (stop_program.load())
                     break;
                 continue;
             }
 
-            while (!channel.data_queue_csv.empty())
+            while ((part = channel.data_ring_csv.peek()) != nullptr)
             {
-                std::shared_ptr<data_part_t> part = channel.data_queue_csv.front();
-                channel.data_queue_csv.pop();
-
                 for (size_t k = 0; k < MODEL_INPUT_DIM_0; k++)
                 {
                     write_scalar(buffer_output_file, part->data[k][0]);
@@ -56,11 +55,12 @@ void write_data_csv(Channel &channel, const std::string &filename)
 
                 fprintf(buffer_output_file, "\n");
                 fflush(buffer_output_file);
+                channel.data_ring_csv.consume();
 
                 channel.write_count_csv.fetch_add(1, std::memory_order_relaxed);
             }
 
-            if (channel.acquisition_done && channel.data_queue_csv.empty())
+            if (channel.acquisition_done.load() && channel.data_ring_csv.empty())
                 break;
         }
 
@@ -0,0 +1,48 @@
+/*ModelContext.cpp*/
+
+#include "ModelContext.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+
+static_assert(MODEL_CONTEXTS >= 1 && MODEL_CONTEXTS <= 4, "MODEL_CONTEXTS must be between 1 and 4");
+
+extern "C"
+{
+    void cnn_ctx0(const input_t input, output_t output);
+#if MODEL_CONTEXTS > 1
+    void cnn_ctx1(const input_t input, output_t output);
+#endif
+#if MODEL_CONTEXTS > 2
+    void cnn_ctx2(const input_t input, output_t output);
+#endif
+#if MODEL_CONTEXTS > 3
+    void cnn_ctx3(const input_t input, output_t output);
+#endif
+}
+
+static ModelContext model_contexts[MODEL_CONTEXTS] = {
+    {0, cnn_ctx0},
+#if MODEL_CONTEXTS > 1
+    {1, cnn_ctx1},
+#endif
+#if MODEL_CONTEXTS > 2
+    {2, cnn_ctx2},
+#endif
+#if MODEL_CONTEXTS > 3
+    {3, cnn_ctx3},
+#endif
+};
+
+static std::atomic<int> next_model_context{0};
+
+ModelContext *acquire_model_context()
+{
+    int id = next_model_context.fetch_add(1);
+    if (id >= MODEL_CONTEXTS)
+    {
+        std::cerr << "ERR: No model context left (MODEL_CONTEXTS=" << MODEL_CONTEXTS << ")" << std::endl;
+        exit(-1);
+    }
+    return &model_contexts[id];
+}
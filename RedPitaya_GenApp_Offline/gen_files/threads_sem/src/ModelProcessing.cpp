@@ -9,9 +9,6 @@
 #define ARM_MATH_DSP 1
 #define ARM_NN_TRUNCATE
 
-extern bool save_output_csv;
-extern bool save_output_dac;
-
 template <typename T>
 void sample_norm(T (&data)[MODEL_INPUT_DIM_0][MODEL_INPUT_DIM_1])
 {
@@ -49,49 +46,37 @@ void model_inference(Channel &channel)
 {
     try
     {
+        const data_part_t *part = nullptr;
+
         while (true)
         {
-            if (sem_wait(&channel.model_sem) != 0)
+            if (!channel.model_ring.wait(&channel.model_sem))
             {
-                if (errno == EINTR && stop_program.load())
+                if (stop_program.load())
                     break;
                 continue;
             }
 
-            if (stop_program.load() && channel.model_queue.empty())
+            if (stop_program.load() && channel.model_ring.empty())
                 break;
 
-            while (!channel.model_queue.empty())
+            while ((part = channel.model_ring.peek()) != nullptr)
             {
-                std::shared_ptr<data_part_t> part = channel.model_queue.front();
-                channel.model_queue.pop();
-
                 model_result_t result;
                 auto start = std::chrono::high_resolution_clock::now();
-                cnn(part->data, result.output);
+                channel.model_ctx->run(part->data, result.output);
                 auto end = std::chrono::high_resolution_clock::now();
                 result.computation_time = std::chrono::duration<double, std::milli>(end - start).count();
+                channel.model_ring.consume();
 
-                if (save_output_csv)
-                {
-                    channel.result_buffer_csv.push_back(result);
-                    sem_post(&channel.result_sem_csv);
-                }
-
-                if (save_output_dac)
-                {
-                    channel.result_buffer_dac.push_back(result);
-                    sem_post(&channel.result_sem_dac);
-                }
-
-                channel.model_count.fetch_add(1, std::memory_order_relaxed);
+                publish_result(channel, result);
             }
 
-            if (channel.acquisition_done && channel.model_queue.empty())
+            if (channel.acquisition_done.load() && channel.model_ring.empty())
                 break;
         }
 
-        channel.processing_done = true;
+        channel.processing_done.store(true);
         if (save_output_csv)
             sem_post(&channel.result_sem_csv);
         if (save_output_dac)
@@ -110,51 +95,40 @@ void model_inference_mod(Channel &channel)
 {
     try
     {
+        const data_part_t *part = nullptr;
+
         while (true)
         {
-            if (sem_wait(&channel.model_sem) != 0)
+            if (!channel.model_ring.wait(&channel.model_sem))
             {
-                if (errno == EINTR && stop_program.load())
+                if (stop_program.load())
                     break;
                 continue;
             }
 
-            if (stop_program.load() && channel.model_queue.empty())
+            if (stop_program.load() && channel.model_ring.empty())
                 break;
 
-            while (!channel.model_queue.empty())
+            while ((part = channel.model_ring.peek()) != nullptr)
             {
-                std::shared_ptr<data_part_t> part = channel.model_queue.front();
-                channel.model_queue.pop();
-
-                sample_norm(part->data); 
+                data_part_t normalized = *part;
+                channel.model_ring.consume();
+                sample_norm(normalized.data);
 
                 model_result_t result;
                 auto start = std::chrono::high_resolution_clock::now();
-                cnn(part->data, result.output);
+                channel.model_ctx->run(normalized.data, result.output);
                 auto end = std::chrono::high_resolution_clock::now();
                 result.computation_time = std::chrono::duration<double, std::milli>(end - start).count();
 
-                if (save_output_csv)
-                {
-                    channel.result_buffer_csv.push_back(result);
-                    sem_post(&channel.result_sem_csv);
-                }
-
-                if (save_output_dac)
-                {
-                    channel.result_buffer_dac.push_back(result);
-                    sem_post(&channel.result_sem_dac);
-                }
-
-                channel.model_count.fetch_add(1, std::memory_order_relaxed);
+                publish_result(channel, result);
             }
 
-            if (channel.acquisition_done && channel.model_queue.empty())
+            if (channel.acquisition_done.load() && channel.model_ring.empty())
                 break;
         }
 
-        channel.processing_done = true;
+        channel.processing_done.store(true);
         if (save_output_csv)
             sem_post(&channel.result_sem_csv);
         if (save_output_dac)
@@ -4,7 +4,6 @@
 #include <iostream>
 #include <cstdio>
 #include <type_traits>
-#include <mutex>
 
 template <typename T>
 void write_output(FILE *file, int index, const T &value, double time_ms)
@@ -35,29 +34,29 @@ void log_results_csv(Channel &channel, const std::string &filename)
         }
 
         int output_index = 1;
+        const model_result_t *result = nullptr;
 
         while (true)
         {
-            if (sem_wait(&channel.result_sem_csv) != 0)
+            if (!channel.result_ring_csv.wait(&channel.result_sem_csv))
             {
-                if (errno == EINTR && stop_program.load())
+                if (stop_program.load())
                     break;
                 continue;
             }
 
-            if (stop_program.load() && channel.result_buffer_csv.empty())
+            if (stop_program.load() && channel.result_ring_csv.empty())
                 break;
 
-            while (!channel.result_buffer_csv.empty())
+            while ((result = channel.result_ring_csv.peek()) != nullptr)
             {
-                const model_result_t &result = channel.result_buffer_csv.front();
-                write_output(output_file, output_index++, result.output[0], result.computation_time);
+                write_output(output_file, output_index++, result->output[0], result->computation_time);
                 fflush(output_file);
-                channel.result_buffer_csv.pop_front();
+                channel.result_ring_csv.consume();
                 channel.log_count_csv.fetch_add(1, std::memory_order_relaxed);
             }
 
-            if (channel.processing_done && channel.result_buffer_csv.empty())
+            if (channel.processing_done.load() && channel.result_ring_csv.empty())
                 break;
         }
 
@@ -1,37 +1,38 @@
 /*ModelWriterDAC.cpp*/
 
 #include "ModelWriterDAC.hpp"
+#include <algorithm>
 #include <iostream>
-#include <mutex>
 #include <type_traits>
 
 void log_results_dac(Channel &channel, rp_channel_t rp_channel)
 {
     try
     {
+        const model_result_t *result = nullptr;
+
         while (true)
         {
-            if (sem_wait(&channel.result_sem_dac) != 0)
+            if (!channel.result_ring_dac.wait(&channel.result_sem_dac))
             {
-                if (errno == EINTR && stop_program.load())
+                if (stop_program.load())
                     break;
                 continue;
             }
 
-            if (stop_program.load() && channel.result_buffer_dac.empty())
+            if (stop_program.load() && channel.result_ring_dac.empty())
                 break;
 
-            while (!channel.result_buffer_dac.empty())
+            while ((result = channel.result_ring_dac.peek()) != nullptr)
             {
-                const model_result_t &result = channel.result_buffer_dac.front();
-                float voltage = OutputToVoltage(result.output[0]);
+                float voltage = OutputToVoltage(result->output[0]);
                 voltage = std::clamp(voltage, -1.0f, 1.0f);
                 rp_GenAmp(rp_channel, voltage);
-                channel.result_buffer_dac.pop_front();
+                channel.result_ring_dac.consume();
                 channel.log_count_dac.fetch_add(1, std::memory_order_relaxed);
             }
 
-            if (channel.processing_done && channel.result_buffer_dac.empty())
+            if (channel.processing_done.load() && channel.result_ring_dac.empty())
                 break;
         }
 
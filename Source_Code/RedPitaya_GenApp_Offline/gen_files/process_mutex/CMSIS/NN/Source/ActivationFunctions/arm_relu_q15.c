@@ -47,14 +47,30 @@
  *
  * @details
  *
- * Optimized relu with QSUB instructions.
+ * Optimized relu with QSUB instructions, or VMAX when built with ARM_MATH_NEON.
  *
  */
 
-void arm_relu_q15(q15_t *data, uint16_t size)
+void (arm_relu_q15)(q15_t *data, uint16_t size)
 {
 
-#if defined(ARM_MATH_DSP) && !defined(ARM_MATH_MVEI)
+#if defined(ARM_MATH_NEON)
+    /* Run the following code for Cortex-A cores with NEON */
+
+    uint16_t i = 0;
+    const int16x8_t zero = vdupq_n_s16(0);
+
+    for (; i + 8 <= size; i += 8)
+    {
+        vst1q_s16(data + i, vmaxq_s16(vld1q_s16(data + i), zero));
+    }
+
+    for (; i < size; i++)
+    {
+        if (data[i] < 0)
+            data[i] = 0;
+    }
+#elif defined(ARM_MATH_DSP) && !defined(ARM_MATH_MVEI)
     /* Run the following code for M cores with DSP extension */
 
     uint16_t i = size >> 1;
@@ -12,6 +12,7 @@
 #include <queue>
 #include <deque>
 #include <chrono>
+#include <cmath>
 #include <atomic>
 #include <memory>
 #include <string>
@@ -1,6 +1,7 @@
 /* DataWriterDAC.cpp */
 
 #include "DataWriterDAC.hpp"
+#include <algorithm>
 #include <iostream>
 
 void write_data_dac(Channel &channel, rp_channel_t rp_channel)
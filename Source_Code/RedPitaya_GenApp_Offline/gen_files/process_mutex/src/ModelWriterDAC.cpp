@@ -1,6 +1,7 @@
 /*ModelWriterDAC.cpp*/
 
 #include "ModelWriterDAC.hpp"
+#include <algorithm>
 #include <iostream>
 
 void log_results_dac(Channel &channel, rp_channel_t rp_channel)
@@ -603,6 +603,71 @@ arm_status arm_convolve_HWC_q15_basic_nonsquare(const q15_t *Im_in,
                                       q15_t *bufferA,
                                       q7_t *bufferB);
 
+/**
+ * @brief Basic Q15 convolution over a batch of images (non-square shape)
+ * @param[in]       Im_in        pointer to batch input tensors, each dim_im_in_y x dim_im_in_x x ch_im_in
+ * @param[in,out]   Im_out       pointer to batch output tensors, each dim_im_out_y x dim_im_out_x x ch_im_out
+ * @param[in,out]   bufferA      pointer to buffer space for input, batch*ch_im_in*dim_kernel_x*dim_kernel_y
+ * @param[in]       batch        number of images
+ *
+ * Other parameters as arm_convolve_HWC_q15_basic_nonsquare. The im2col columns
+ * of every image are gathered first so each filter is applied to the whole
+ * batch while it is cache resident. Results are identical to calling
+ * arm_convolve_HWC_q15_basic_nonsquare once per image.
+ */
+arm_status arm_convolve_HWC_q15_basic_nonsquare_batch(const q15_t *Im_in,
+                                                      const uint16_t dim_im_in_x,
+                                                      const uint16_t dim_im_in_y,
+                                                      const uint16_t ch_im_in,
+                                                      const q15_t *wt,
+                                                      const uint16_t ch_im_out,
+                                                      const uint16_t dim_kernel_x,
+                                                      const uint16_t dim_kernel_y,
+                                                      const uint16_t padding_x,
+                                                      const uint16_t padding_y,
+                                                      const uint16_t stride_x,
+                                                      const uint16_t stride_y,
+                                                      const q15_t *bias,
+                                                      const uint16_t bias_shift,
+                                                      const uint16_t out_shift,
+                                                      q15_t *Im_out,
+                                                      const uint16_t dim_im_out_x,
+                                                      const uint16_t dim_im_out_y,
+                                                      q15_t *bufferA,
+                                                      const uint16_t batch);
+
+/**
+ * @brief Basic Q15 convolution of a window that slid along x (non-square shape)
+ * @param[in,out]   Im_out       output of the previous window, updated in place
+ * @param[in,out]   bufferA      pointer to buffer space for input, ch_im_in*dim_kernel_x*dim_kernel_y
+ * @param[in]       shift_x      number of input columns the window advanced since Im_out was computed
+ *
+ * Other parameters as arm_convolve_HWC_q15_basic_nonsquare. Output columns that
+ * only see samples of the previous window are moved instead of recomputed, so
+ * streaming overlapping windows costs the new columns only. Results are
+ * identical to arm_convolve_HWC_q15_basic_nonsquare on the new window.
+ */
+arm_status arm_convolve_HWC_q15_basic_nonsquare_incremental(const q15_t *Im_in,
+                                                            const uint16_t dim_im_in_x,
+                                                            const uint16_t dim_im_in_y,
+                                                            const uint16_t ch_im_in,
+                                                            const q15_t *wt,
+                                                            const uint16_t ch_im_out,
+                                                            const uint16_t dim_kernel_x,
+                                                            const uint16_t dim_kernel_y,
+                                                            const uint16_t padding_x,
+                                                            const uint16_t padding_y,
+                                                            const uint16_t stride_x,
+                                                            const uint16_t stride_y,
+                                                            const q15_t *bias,
+                                                            const uint16_t bias_shift,
+                                                            const uint16_t out_shift,
+                                                            q15_t *Im_out,
+                                                            const uint16_t dim_im_out_x,
+                                                            const uint16_t dim_im_out_y,
+                                                            q15_t *bufferA,
+                                                            const uint16_t shift_x);
+
 /**
  * @brief Fast Q7 convolution function
  * @param[in]       Im_in       pointer to input tensor
@@ -1531,6 +1596,33 @@ arm_status arm_fully_connected_q15(const q15_t *pV,
                                    q15_t *pOut,
                                    q15_t *vec_buffer);
 
+/**
+ * @brief Q15 fully-connected layer over a batch of input vectors (matrix-matrix)
+ * @param[in]       pV          pointer to batch input vectors, batch x dim_vec
+ * @param[in]       pM          pointer to matrix weights
+ * @param[in]       dim_vec     length of the vector
+ * @param[in]       num_of_rows number of rows in weight matrix
+ * @param[in]       bias_shift  amount of left-shift for bias
+ * @param[in]       out_shift   amount of right-shift for output
+ * @param[in]       bias        pointer to bias
+ * @param[in,out]   pOut        pointer to batch output vectors, batch x num_of_rows
+ * @param[in]       batch       number of input vectors
+ * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+ *
+ * Each weight row is applied to every vector of the batch before moving on, so
+ * it is read from memory once per batch. Results are identical to calling
+ * arm_fully_connected_q15 once per vector.
+ */
+arm_status arm_fully_connected_q15_batch(const q15_t *pV,
+                                         const q15_t *pM,
+                                         const uint16_t dim_vec,
+                                         const uint16_t num_of_rows,
+                                         const uint16_t bias_shift,
+                                         const uint16_t out_shift,
+                                         const q15_t *bias,
+                                         q15_t *pOut,
+                                         const uint16_t batch);
+
 /**
  * @brief Q15 opt fully-connected layer function
  * @param[in]       pV          pointer to input vector
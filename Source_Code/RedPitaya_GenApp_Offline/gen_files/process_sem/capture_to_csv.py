@@ -0,0 +1,135 @@
+import os
+import re
+import struct
+import sys
+
+# Converts DataOutput/data_chX.bin (see include/CaptureFormat.hpp) to the data_chX.csv layout
+# written by write_data_csv, so plot.py and existing scripts keep working on binary captures.
+# When the capture was split with WRITER_SEGMENT_MB / WRITER_SEGMENT_SECONDS, data_chX.bin does
+# not exist; its segments data_chX.NNNNNN.bin are then stitched into one data_chX.csv in order.
+#
+#   python3 capture_to_csv.py DataOutput/data_ch1.bin [DataOutput/data_ch1.csv]
+
+CAPTURE_MAGIC = b'RPCAPT\r\n'
+HEADER = struct.Struct('<8sHHBBHIIIdQQ')
+RECORD = struct.Struct('<IIQ')
+GAP = struct.Struct('<QQ')
+
+RECORD_WINDOW = 1
+RECORD_GAP = 2
+RECORD_WINDOW_RICE = 3
+
+RICE_ESCAPE = 24
+
+SAMPLE_FORMATS = {1: ('b', '%d'), 2: ('h', '%d'), 3: ('f', '%.6f')}
+
+
+def segment_paths(path):
+    # path itself if it exists, otherwise its numbered segments stem.NNNNNN.ext in segment order.
+    if os.path.exists(path):
+        return [path]
+    directory = os.path.dirname(path) or '.'
+    stem, extension = os.path.splitext(os.path.basename(path))
+    pattern = re.compile(re.escape(stem) + r'\.(\d{6,})' + re.escape(extension) + '$')
+    if not os.path.isdir(directory):
+        return []
+    numbered = []
+    for name in os.listdir(directory):
+        match = pattern.match(name)
+        if match:
+            numbered.append((int(match.group(1)), os.path.join(directory, name)))
+    return [segment for _, segment in sorted(numbered)]
+
+
+def rice_decode(payload, count):
+    # Inverse of rice_encode in include/RiceCodec.hpp.
+    k = payload[0]
+    bits = int.from_bytes(payload[1:], 'little')
+    pos = 0
+    previous = 0
+    samples = []
+    for _ in range(count):
+        rest = bits >> pos
+        ones = (rest ^ (rest + 1)).bit_length() - 1
+        if ones >= RICE_ESCAPE:
+            pos += RICE_ESCAPE
+            u = (bits >> pos) & 0xFFFFFFFF
+            pos += 32
+        else:
+            pos += ones + 1
+            u = (ones << k) | ((bits >> pos) & ((1 << k) - 1))
+            pos += k
+        previous += (u >> 1) ^ -(u & 1)
+        samples.append(previous)
+    return samples
+
+
+def convert_segment(bin_path, dst, state):
+    with open(bin_path, 'rb') as src:
+        fields = HEADER.unpack(src.read(HEADER.size))
+        magic, version, header_size, channel, sample_type, sample_size, window_samples, hop_samples, decimation, \
+            sample_rate_hz, trigger_monotonic_ns, trigger_unix_ns = fields
+        if magic != CAPTURE_MAGIC:
+            sys.exit(f'{bin_path}: not a binary capture')
+        if sample_type not in SAMPLE_FORMATS:
+            sys.exit(f'{bin_path}: unknown sample type {sample_type}')
+        if state.get('window_samples', window_samples) != window_samples:
+            sys.exit(f'{bin_path}: {window_samples}-sample windows, earlier segments have {state["window_samples"]}')
+        state.update(channel=channel, window_samples=window_samples, decimation=decimation,
+                     sample_rate_hz=sample_rate_hz)
+        src.seek(header_size)
+
+        code, text = SAMPLE_FORMATS[sample_type]
+        window = struct.Struct(f'<{window_samples}{code}')
+        line = ','.join([text] * window_samples) + '\n'
+        # Overlapping windows (MODEL_HOP_SIZE): announced before the segment's first window, as the CSV sink does
+        announce_hop = hop_samples < window_samples
+
+        while True:
+            head = src.read(RECORD.size)
+            if len(head) < RECORD.size:
+                break
+            record_type, size, seq = RECORD.unpack(head)
+            payload = src.read(size)
+            if len(payload) < size:
+                print(f'{bin_path}: truncated record at window {seq}', file=sys.stderr)
+                break
+
+            if record_type == RECORD_GAP:
+                gap_samples, gap_time_ns = GAP.unpack(payload)
+                dst.write('# gap,%d,%d\n' % (gap_samples, gap_time_ns))
+            elif record_type in (RECORD_WINDOW, RECORD_WINDOW_RICE):
+                if announce_hop:
+                    dst.write('# hop,%d,%d\n' % (hop_samples, seq))
+                    announce_hop = False
+                if record_type == RECORD_WINDOW:
+                    dst.write(line % window.unpack(payload))
+                else:
+                    dst.write(line % tuple(rice_decode(payload, window_samples)))
+                if state['next_seq'] is not None and seq > state['next_seq']:
+                    state['missing'] += seq - state['next_seq']
+                state['next_seq'] = seq + 1
+                state['windows'] += 1
+
+
+def convert(bin_paths, csv_path):
+    state = {'windows': 0, 'missing': 0, 'next_seq': None}
+    with open(csv_path, 'w') as dst:
+        for bin_path in bin_paths:
+            convert_segment(bin_path, dst, state)
+
+    segments = f' from {len(bin_paths)} segments' if len(bin_paths) > 1 else ''
+    print(f'CH{state["channel"]}: {state["windows"]} windows of {state["window_samples"]} samples{segments}, '
+          f'DECIMATION {state["decimation"]} ({state["sample_rate_hz"]:.2f} Hz), '
+          f'{state["missing"]} windows dropped before the writer -> {csv_path}')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        sys.exit('usage: capture_to_csv.py data_chX.bin [data_chX.csv]')
+    bin_path = sys.argv[1]
+    bin_paths = segment_paths(bin_path)
+    if not bin_paths:
+        sys.exit(f'{bin_path}: no such capture or segments')
+    csv_path = sys.argv[2] if len(sys.argv) > 2 else bin_path.rsplit('.', 1)[0] + '.csv'
+    convert(bin_paths, csv_path)
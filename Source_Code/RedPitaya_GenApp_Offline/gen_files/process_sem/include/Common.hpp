@@ -9,8 +9,6 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
-#include <deque>
 #include <chrono>
 #include <atomic>
 #include <memory>
@@ -18,14 +16,113 @@
 #include <sys/stat.h>
 #include <dirent.h>
 #include <semaphore.h>
+#include <cmath>
 
 #include "rp.h"
 #include "../model/include/model.h"
+#include "BroadcastRing.hpp"
+#include "SpscRing.hpp"
+#include "ConvertRaw.hpp"
+#include "LayerProfile.h"
 
 #define DATA_SIZE 16384
 #define QUEUE_MAX_SIZE 1000000
+#define RING_CAPACITY 4096
+#ifndef DATA_RING_CAPACITY
+#define DATA_RING_CAPACITY 1024
+#endif
+#ifndef DECIMATION
 #define DECIMATION (125000 / MODEL_INPUT_DIM_0)
+#endif
+/* New samples per window; below MODEL_INPUT_DIM_0 consecutive windows overlap by the difference. */
+#ifndef MODEL_HOP_SIZE
+#define MODEL_HOP_SIZE MODEL_INPUT_DIM_0
+#endif
+#ifndef ACQ_ZERO_COPY
+#define ACQ_ZERO_COPY 1
+#endif
+#ifndef ACQ_OVERRUN_RESYNC
+#define ACQ_OVERRUN_RESYNC 0
+#endif
+#ifndef ACQ_NORMALIZE
+#define ACQ_NORMALIZE 0
+#endif
+#ifndef ACQ_MAX_CHUNKS_PER_DRAIN
+#define ACQ_MAX_CHUNKS_PER_DRAIN (DATA_SIZE / MODEL_HOP_SIZE)
+#endif
 #define DISK_SPACE_THRESHOLD 0.2 * 1024 * 1024 * 1024
+#if defined(Z20_250_12)
+#define ADC_SAMPLE_RATE 250000000.0
+#elif defined(Z20)
+#define ADC_SAMPLE_RATE 122880000.0
+#else
+#define ADC_SAMPLE_RATE 125000000.0
+#endif
+#define ACQ_POLL_SPIN 0
+#define ACQ_POLL_HYBRID 1
+#define ACQ_POLL_SLEEP 2
+#ifndef ACQ_POLL_POLICY
+#define ACQ_POLL_POLICY ACQ_POLL_HYBRID
+#endif
+#ifndef ACQ_SPIN_MARGIN_US
+#define ACQ_SPIN_MARGIN_US 50
+#endif
+#ifndef MODEL_BATCH_MAX
+#define MODEL_BATCH_MAX 8
+#endif
+#ifndef MODEL_BATCH_LATENCY_US
+#define MODEL_BATCH_LATENCY_US 2000
+#endif
+#define MODEL_SHED_NONE 0
+#define MODEL_SHED_SKIP 1
+#define MODEL_SHED_DECIMATE 2
+#define MODEL_SHED_FALLBACK 3
+#ifndef MODEL_SHED_POLICY
+#define MODEL_SHED_POLICY MODEL_SHED_NONE
+#endif
+#ifndef MODEL_LATENCY_BUDGET_US
+#define MODEL_LATENCY_BUDGET_US 100000
+#endif
+#ifndef MODEL_SHED_DECIMATE_K
+#define MODEL_SHED_DECIMATE_K 4
+#endif
+#ifndef MODEL_SHED_PROBE_N
+#define MODEL_SHED_PROBE_N 8
+#endif
+#define WRITER_DURABILITY_NONE 0
+#define WRITER_DURABILITY_PERIODIC 1
+#define WRITER_DURABILITY_ON_STOP 2
+#ifndef WRITER_DURABILITY
+#define WRITER_DURABILITY WRITER_DURABILITY_ON_STOP
+#endif
+#ifndef WRITER_BUFFER_SIZE
+#define WRITER_BUFFER_SIZE (1 << 20)
+#endif
+#ifndef WRITER_FLUSH_INTERVAL_MS
+#define WRITER_FLUSH_INTERVAL_MS 1000
+#endif
+#ifndef CAPTURE_COMPRESS
+#define CAPTURE_COMPRESS 0
+#endif
+#ifndef WRITER_FSYNC_INTERVAL_MS
+#define WRITER_FSYNC_INTERVAL_MS 5000
+#endif
+#ifndef WRITER_SEGMENT_MB
+#define WRITER_SEGMENT_MB 0
+#endif
+#ifndef WRITER_SEGMENT_SECONDS
+#define WRITER_SEGMENT_SECONDS 0
+#endif
+#define WRITER_SEGMENTED (WRITER_SEGMENT_MB > 0 || WRITER_SEGMENT_SECONDS > 0)
+#ifndef WRITER_INDEX_INTERVAL_MS
+#define WRITER_INDEX_INTERVAL_MS 1000
+#endif
+#ifndef WRITER_RETENTION
+#define WRITER_RETENTION 0
+#endif
+#ifndef DISK_MONITOR_INTERVAL_MS
+#define DISK_MONITOR_INTERVAL_MS 500
+#endif
 #define acq_priority 1
 #define write__csv_priority 1
 #define write_dac_priority 1
@@ -35,20 +132,30 @@
 #define SHM_COUNTERS "/channel_counters"
 
 extern bool save_data_csv;
+extern bool save_data_bin;
 extern bool save_data_dac;
 extern bool save_output_csv;
 extern bool save_output_dac;
 
 
-struct data_part_t
+struct alignas(CACHE_LINE_SIZE) data_part_t
 {
     input_t data;
+    uint32_t hop = 0;
+    uint64_t seq = 0;
+    uint64_t acq_time_ns = 0;
+    uint64_t gap_samples = 0;
+    uint64_t gap_time_ns = 0;
 };
 
 struct model_result_t
 {
     output_t output;
     double computation_time;
+    uint64_t seq = 0;
+    uint64_t acq_time_ns = 0;
+    uint64_t gap_samples = 0;
+    uint64_t gap_time_ns = 0;
 };
 
 struct shared_counters_t
@@ -56,23 +163,63 @@ struct shared_counters_t
     std::atomic<int> acquire_count;
     std::atomic<int> model_count;
     std::atomic<int> write_count_csv;
+    std::atomic<int> write_count_bin;
     std::atomic<int> write_count_dac;
     std::atomic<int> log_count_csv;
     std::atomic<int> log_count_dac;
+    std::atomic<int> ring_full_count;
+    std::atomic<int> model_queue_full_count;
+    std::atomic<int> sink_slot_full_count;
+    std::atomic<int> data_drop_csv;
+    std::atomic<int> data_drop_bin;
+    std::atomic<int> data_drop_dac;
+    std::atomic<int> result_drop_csv;
+    std::atomic<int> result_drop_dac;
+    std::atomic<int> drain_count;
+    std::atomic<int> drained_chunks;
+    std::atomic<int> max_chunks_per_drain;
+    std::atomic<int> wake_count;
+    std::atomic<int> overrun_count;
+    std::atomic<int> batch_count;
+    std::atomic<int> batched_windows;
+    std::atomic<int> max_batch;
+    std::atomic<int> shed_count;
+    std::atomic<int> fallback_count;
+    std::atomic<uint64_t> output_latency_total_us;
+    std::atomic<uint64_t> output_latency_max_us;
+    std::atomic<uint64_t> lost_samples;
+    std::atomic<uint64_t> writer_bytes;
+    std::atomic<int> writer_flushes;
+    std::atomic<int> writer_fsyncs;
+    std::atomic<uint64_t> writer_flush_total_us;
+    std::atomic<uint64_t> writer_flush_max_us;
+    std::atomic<int> segments_opened;
+    std::atomic<int> segments_deleted;
+    std::atomic<uint64_t> compress_raw_bytes;
+    std::atomic<uint64_t> compress_bytes;
+    std::atomic<uint64_t> compress_total_ns;
+    std::atomic<uint64_t> wake_jitter_total_ns;
+    std::atomic<uint64_t> wake_jitter_max_ns;
     std::atomic<uint64_t> trigger_time_ns;
     std::atomic<uint64_t> end_time_ns;
     std::atomic<int> ready_barrier;
+    layer_profile_t layer_profile;
 };
 
 struct Channel
 {
-    std::queue<std::shared_ptr<data_part_t>> data_queue_csv;
-    std::queue<std::shared_ptr<data_part_t>> data_queue_dac;
-    std::queue<std::shared_ptr<data_part_t>> model_queue;
-    std::deque<model_result_t> result_buffer_csv;
-    std::deque<model_result_t> result_buffer_dac;
+    SpscRing<data_part_t, DATA_RING_CAPACITY> model_ring;
+    BroadcastRing<data_part_t, DATA_RING_CAPACITY> data_ring;
+    BroadcastRing<model_result_t, RING_CAPACITY> result_ring;
+
+    int data_csv_reader = -1;
+    int data_bin_reader = -1;
+    int data_dac_reader = -1;
+    int result_csv_reader = -1;
+    int result_dac_reader = -1;
 
     sem_t data_sem_csv;
+    sem_t data_sem_bin;
     sem_t data_sem_dac;
     sem_t model_sem;
     sem_t result_sem_csv;
@@ -83,8 +230,8 @@ struct Channel
     std::chrono::steady_clock::time_point trigger_time_point;
     std::chrono::steady_clock::time_point end_time_point;
 
-    bool acquisition_done = false;
-    bool processing_done = false;
+    std::atomic<bool> acquisition_done{false};
+    std::atomic<bool> processing_done{false};
     bool channel_triggered = false;
 
     shared_counters_t *counters = nullptr;
@@ -99,29 +246,7 @@ extern std::atomic<bool> stop_program;
 
 extern Channel channel1, channel2;
 
+void register_channel_sinks(Channel &channel);
+
 extern pid_t pid1;
 extern pid_t pid2;
-
-template <typename T>
-inline void convert_raw_data(const int16_t *src, T dst[MODEL_INPUT_DIM_0][1], size_t count)
-{
-    for (size_t i = 0; i < count; ++i)
-    {
-        if constexpr (std::is_same<T, float>::value)
-        {
-            dst[i][0] = static_cast<float>(src[i]) / 8192.0f;
-        }
-        else if constexpr (std::is_same<T, int8_t>::value)
-        {
-            dst[i][0] = static_cast<int8_t>(std::round(src[i] / 64.0f));
-        }
-        else if constexpr (std::is_same<T, int16_t>::value)
-        {
-            dst[i][0] = src[i];
-        }
-        else
-        {
-            static_assert(!sizeof(T *), "Unsupported data type in convert_raw_data.");
-        }
-    }
-}
@@ -0,0 +1,440 @@
+/*ConvertRaw.hpp*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "../model/include/model.h"
+
+/* Reference conversion of one raw 14-bit ADC sample into the model input type. */
+template <typename T>
+inline T convert_sample(int16_t raw)
+{
+    if constexpr (std::is_same<T, float>::value)
+    {
+        return static_cast<float>(raw) / 8192.0f;
+    }
+    else if constexpr (std::is_same<T, int8_t>::value)
+    {
+        return static_cast<int8_t>(std::clamp(std::round(raw / 64.0f), -128.0f, 127.0f));
+    }
+    else if constexpr (std::is_same<T, int16_t>::value)
+    {
+        return raw;
+    }
+    else
+    {
+        static_assert(!sizeof(T *), "Unsupported data type in convert_raw_data.");
+    }
+}
+
+template <typename T>
+inline void convert_raw_data_scalar(const int16_t *src, T dst[MODEL_INPUT_DIM_0][1], size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        dst[i][0] = convert_sample<T>(src[i]);
+}
+
+#if defined(__ARM_NEON)
+/* NEON versions, 8 samples per iteration; results are identical to the scalar reference. */
+template <typename T>
+inline void convert_raw_data_neon(const int16_t *src, T dst[MODEL_INPUT_DIM_0][1], size_t count)
+{
+    T *out = &dst[0][0];
+    size_t i = 0;
+
+    if constexpr (std::is_same<T, float>::value)
+    {
+        const float32x4_t scale = vdupq_n_f32(1.0f / 8192.0f);
+        for (; i + 8 <= count; i += 8)
+        {
+            int16x8_t raw = vld1q_s16(src + i);
+            vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(raw))), scale));
+            vst1q_f32(out + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(raw))), scale));
+        }
+    }
+    else if constexpr (std::is_same<T, int8_t>::value)
+    {
+        /* Round half away from zero like std::round: add 32, minus one for negative samples, then narrow with saturation. */
+        const int16x8_t half = vdupq_n_s16(32);
+        for (; i + 8 <= count; i += 8)
+        {
+            int16x8_t raw = vld1q_s16(src + i);
+            int16x8_t biased = vqaddq_s16(raw, vaddq_s16(half, vshrq_n_s16(raw, 15)));
+            vst1_s8(out + i, vqshrn_n_s16(biased, 6));
+        }
+    }
+    else if constexpr (std::is_same<T, int16_t>::value)
+    {
+        for (; i + 8 <= count; i += 8)
+            vst1q_s16(out + i, vld1q_s16(src + i));
+    }
+
+    if (i < count)
+        convert_raw_data_scalar(src + i, reinterpret_cast<T(*)[1]>(out + i), count - i);
+}
+#endif
+
+template <typename T>
+inline void convert_raw_data(const int16_t *src, T dst[MODEL_INPUT_DIM_0][1], size_t count)
+{
+#if defined(__ARM_NEON)
+    convert_raw_data_neon(src, dst, count);
+#else
+    convert_raw_data_scalar(src, dst, count);
+#endif
+}
+
+/* Reference min/max normalisation of a converted window: floats to [0, 1], integer types to 0..512. */
+template <typename T>
+inline void sample_norm(T (&data)[MODEL_INPUT_DIM_0][1])
+{
+    T min_val = data[0][0];
+    T max_val = data[0][0];
+
+    for (size_t i = 1; i < MODEL_INPUT_DIM_0; ++i)
+    {
+        if (data[i][0] < min_val)
+            min_val = data[i][0];
+        if (data[i][0] > max_val)
+            max_val = data[i][0];
+    }
+
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        T range = max_val - min_val;
+        if (range == 0)
+            range = 1;
+        for (size_t i = 0; i < MODEL_INPUT_DIM_0; ++i)
+            data[i][0] = static_cast<T>((data[i][0] - min_val) / static_cast<float>(range));
+    }
+    else
+    {
+        int range = max_val - min_val;
+        if (range == 0)
+            range = 1;
+        for (size_t i = 0; i < MODEL_INPUT_DIM_0; ++i)
+            data[i][0] = static_cast<T>(((data[i][0] - min_val) * 512) / range);
+    }
+}
+
+/*
+ * Per-window constants of the normalisation. Floats multiply by the reciprocal of the range; integer types
+ * replace the division of n = (x - min) * 512 by an exact fixed-point multiply, floor(n / d) == (n * m) >> s
+ * for every n < 2^25 with s = 25 + ceil(log2 d) and m = ceil(2^s / d) (Granlund-Montgomery).
+ */
+template <typename T>
+struct norm_params_t
+{
+    T min;
+    float inv_range;
+    uint32_t multiplier;
+    int shift;
+};
+
+template <typename T>
+inline norm_params_t<T> make_norm_params(T min_val, T max_val)
+{
+    norm_params_t<T> params{};
+    params.min = min_val;
+
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        T range = max_val - min_val;
+        if (range == 0)
+            range = 1;
+        params.inv_range = 1.0f / range;
+    }
+    else
+    {
+        uint32_t range = static_cast<uint32_t>(max_val - min_val);
+        if (range == 0)
+            range = 1;
+        int log2_range = 0;
+        while ((1u << log2_range) < range)
+            log2_range++;
+        params.shift = 25 + log2_range;
+        params.multiplier = static_cast<uint32_t>(((1ULL << params.shift) + range - 1) / range);
+    }
+    return params;
+}
+
+template <typename T>
+inline T apply_norm(T value, const norm_params_t<T> &params)
+{
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        return (value - params.min) * params.inv_range;
+    }
+    else
+    {
+        uint32_t n = static_cast<uint32_t>(value - params.min) << 9;
+        return static_cast<T>(static_cast<uint32_t>((static_cast<uint64_t>(n) * params.multiplier) >> params.shift));
+    }
+}
+
+/* Scalar versions of the fused kernels: raw samples (or a converted window) in, normalised window out. */
+template <typename T>
+inline void convert_normalize_raw_data_scalar(const int16_t *src, T dst[MODEL_INPUT_DIM_0][1], size_t count)
+{
+    int16_t min_raw = src[0];
+    int16_t max_raw = src[0];
+    for (size_t i = 1; i < count; ++i)
+    {
+        min_raw = std::min(min_raw, src[i]);
+        max_raw = std::max(max_raw, src[i]);
+    }
+
+    /* The conversion is monotonic, so the extremes of the converted window are the converted extremes. */
+    const norm_params_t<T> params = make_norm_params(convert_sample<T>(min_raw), convert_sample<T>(max_raw));
+    for (size_t i = 0; i < count; ++i)
+        dst[i][0] = apply_norm(convert_sample<T>(src[i]), params);
+}
+
+template <typename T>
+inline void normalize_window_scalar(const T src[MODEL_INPUT_DIM_0][1], T dst[MODEL_INPUT_DIM_0][1], size_t count)
+{
+    T min_val = src[0][0];
+    T max_val = src[0][0];
+    for (size_t i = 1; i < count; ++i)
+    {
+        min_val = std::min(min_val, src[i][0]);
+        max_val = std::max(max_val, src[i][0]);
+    }
+
+    const norm_params_t<T> params = make_norm_params(min_val, max_val);
+    for (size_t i = 0; i < count; ++i)
+        dst[i][0] = apply_norm(src[i][0], params);
+}
+
+#if defined(__ARM_NEON)
+/* Horizontal min/max of 8-lane accumulators (ARMv7 has no across-vector reduction). */
+inline int16_t neon_reduce_min(int16x8_t v)
+{
+    int16x4_t r = vmin_s16(vget_low_s16(v), vget_high_s16(v));
+    r = vpmin_s16(r, r);
+    r = vpmin_s16(r, r);
+    return vget_lane_s16(r, 0);
+}
+
+inline int16_t neon_reduce_max(int16x8_t v)
+{
+    int16x4_t r = vmax_s16(vget_low_s16(v), vget_high_s16(v));
+    r = vpmax_s16(r, r);
+    r = vpmax_s16(r, r);
+    return vget_lane_s16(r, 0);
+}
+
+inline float neon_reduce_min(float32x4_t v)
+{
+    float32x2_t r = vmin_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpmin_f32(r, r), 0);
+}
+
+inline float neon_reduce_max(float32x4_t v)
+{
+    float32x2_t r = vmax_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpmax_f32(r, r), 0);
+}
+
+/* 8 integer input samples widened to 16 bits. */
+inline int16x8_t neon_load_s16(const int8_t *in)
+{
+    return vmovl_s8(vld1_s8(in));
+}
+
+inline int16x8_t neon_load_s16(const int16_t *in)
+{
+    return vld1q_s16(in);
+}
+
+/* Integer normalisation of 8 lanes already converted to the input type (and widened to 16 bits). */
+template <typename T>
+inline uint16x8_t neon_apply_norm(int16x8_t value, const norm_params_t<T> &params)
+{
+    const uint32x2_t multiplier = vdup_n_u32(params.multiplier);
+    const int64x2_t shift = vdupq_n_s64(-params.shift);
+
+    uint16x8_t diff = vreinterpretq_u16_s16(vsubq_s16(value, vdupq_n_s16(params.min)));
+    uint32x4_t n_lo = vshll_n_u16(vget_low_u16(diff), 9);
+    uint32x4_t n_hi = vshll_n_u16(vget_high_u16(diff), 9);
+
+    uint32x4_t q_lo = vcombine_u32(vmovn_u64(vshlq_u64(vmull_u32(vget_low_u32(n_lo), multiplier), shift)),
+                                   vmovn_u64(vshlq_u64(vmull_u32(vget_high_u32(n_lo), multiplier), shift)));
+    uint32x4_t q_hi = vcombine_u32(vmovn_u64(vshlq_u64(vmull_u32(vget_low_u32(n_hi), multiplier), shift)),
+                                   vmovn_u64(vshlq_u64(vmull_u32(vget_high_u32(n_hi), multiplier), shift)));
+    return vcombine_u16(vmovn_u32(q_lo), vmovn_u32(q_hi));
+}
+
+template <typename T>
+inline void neon_store_norm(T *out, int16x8_t value, const norm_params_t<T> &params)
+{
+    if constexpr (std::is_same<T, int8_t>::value)
+        vst1_s8(out, vreinterpret_s8_u8(vmovn_u16(neon_apply_norm(value, params))));
+    else
+        vst1q_s16(out, vreinterpretq_s16_u16(neon_apply_norm(value, params)));
+}
+
+/* NEON versions, 8 samples per iteration; results are identical to the scalar versions above. */
+template <typename T>
+inline void convert_normalize_raw_data_neon(const int16_t *src, T dst[MODEL_INPUT_DIM_0][1], size_t count)
+{
+    if (count < 8)
+    {
+        convert_normalize_raw_data_scalar(src, dst, count);
+        return;
+    }
+
+    T *out = &dst[0][0];
+    int16x8_t min_acc = vld1q_s16(src);
+    int16x8_t max_acc = min_acc;
+    size_t i = 8;
+    for (; i + 8 <= count; i += 8)
+    {
+        int16x8_t raw = vld1q_s16(src + i);
+        min_acc = vminq_s16(min_acc, raw);
+        max_acc = vmaxq_s16(max_acc, raw);
+    }
+    int16_t min_raw = neon_reduce_min(min_acc);
+    int16_t max_raw = neon_reduce_max(max_acc);
+    for (; i < count; ++i)
+    {
+        min_raw = std::min(min_raw, src[i]);
+        max_raw = std::max(max_raw, src[i]);
+    }
+
+    const norm_params_t<T> params = make_norm_params(convert_sample<T>(min_raw), convert_sample<T>(max_raw));
+
+    i = 0;
+    if constexpr (std::is_same<T, float>::value)
+    {
+        const float32x4_t scale = vdupq_n_f32(1.0f / 8192.0f);
+        const float32x4_t min_val = vdupq_n_f32(params.min);
+        const float32x4_t inv_range = vdupq_n_f32(params.inv_range);
+        for (; i + 8 <= count; i += 8)
+        {
+            int16x8_t raw = vld1q_s16(src + i);
+            float32x4_t lo = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(raw))), scale);
+            float32x4_t hi = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(raw))), scale);
+            vst1q_f32(out + i, vmulq_f32(vsubq_f32(lo, min_val), inv_range));
+            vst1q_f32(out + i + 4, vmulq_f32(vsubq_f32(hi, min_val), inv_range));
+        }
+    }
+    else if constexpr (std::is_same<T, int8_t>::value)
+    {
+        const int16x8_t half = vdupq_n_s16(32);
+        for (; i + 8 <= count; i += 8)
+        {
+            int16x8_t raw = vld1q_s16(src + i);
+            int16x8_t biased = vqaddq_s16(raw, vaddq_s16(half, vshrq_n_s16(raw, 15)));
+            neon_store_norm(out + i, vmovl_s8(vqshrn_n_s16(biased, 6)), params);
+        }
+    }
+    else if constexpr (std::is_same<T, int16_t>::value)
+    {
+        for (; i + 8 <= count; i += 8)
+            neon_store_norm(out + i, vld1q_s16(src + i), params);
+    }
+
+    for (; i < count; ++i)
+        out[i] = apply_norm(convert_sample<T>(src[i]), params);
+}
+
+template <typename T>
+inline void normalize_window_neon(const T src[MODEL_INPUT_DIM_0][1], T dst[MODEL_INPUT_DIM_0][1], size_t count)
+{
+    if (count < 8)
+    {
+        normalize_window_scalar(src, dst, count);
+        return;
+    }
+
+    const T *in = &src[0][0];
+    T *out = &dst[0][0];
+    T min_val, max_val;
+    size_t i = 8;
+
+    if constexpr (std::is_same<T, float>::value)
+    {
+        float32x4_t min_acc = vminq_f32(vld1q_f32(in), vld1q_f32(in + 4));
+        float32x4_t max_acc = vmaxq_f32(vld1q_f32(in), vld1q_f32(in + 4));
+        for (; i + 8 <= count; i += 8)
+        {
+            float32x4_t lo = vld1q_f32(in + i);
+            float32x4_t hi = vld1q_f32(in + i + 4);
+            min_acc = vminq_f32(min_acc, vminq_f32(lo, hi));
+            max_acc = vmaxq_f32(max_acc, vmaxq_f32(lo, hi));
+        }
+        min_val = neon_reduce_min(min_acc);
+        max_val = neon_reduce_max(max_acc);
+    }
+    else
+    {
+        int16x8_t min_acc = neon_load_s16(in);
+        int16x8_t max_acc = min_acc;
+        for (; i + 8 <= count; i += 8)
+        {
+            int16x8_t value = neon_load_s16(in + i);
+            min_acc = vminq_s16(min_acc, value);
+            max_acc = vmaxq_s16(max_acc, value);
+        }
+        min_val = static_cast<T>(neon_reduce_min(min_acc));
+        max_val = static_cast<T>(neon_reduce_max(max_acc));
+    }
+    for (size_t j = i; j < count; ++j)
+    {
+        min_val = std::min(min_val, in[j]);
+        max_val = std::max(max_val, in[j]);
+    }
+
+    const norm_params_t<T> params = make_norm_params(min_val, max_val);
+
+    i = 0;
+    if constexpr (std::is_same<T, float>::value)
+    {
+        const float32x4_t min_vec = vdupq_n_f32(params.min);
+        const float32x4_t inv_range = vdupq_n_f32(params.inv_range);
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(out + i, vmulq_f32(vsubq_f32(vld1q_f32(in + i), min_vec), inv_range));
+    }
+    else
+    {
+        for (; i + 8 <= count; i += 8)
+            neon_store_norm(out + i, neon_load_s16(in + i), params);
+    }
+
+    for (; i < count; ++i)
+        out[i] = apply_norm(in[i], params);
+}
+#endif
+
+/* Raw samples to a normalised window in one kernel, for the acquisition thread (ACQ_NORMALIZE). */
+template <typename T>
+inline void convert_normalize_raw_data(const int16_t *src, T dst[MODEL_INPUT_DIM_0][1], size_t count)
+{
+#if defined(__ARM_NEON)
+    convert_normalize_raw_data_neon(src, dst, count);
+#else
+    convert_normalize_raw_data_scalar(src, dst, count);
+#endif
+}
+
+/* Converted window to a normalised copy, for the model thread; replaces memcpy + sample_norm. */
+template <typename T>
+inline void normalize_window(const T src[MODEL_INPUT_DIM_0][1], T dst[MODEL_INPUT_DIM_0][1], size_t count)
+{
+#if defined(__ARM_NEON)
+    normalize_window_neon(src, dst, count);
+#else
+    normalize_window_scalar(src, dst, count);
+#endif
+}
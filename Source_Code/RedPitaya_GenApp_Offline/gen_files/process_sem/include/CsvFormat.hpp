@@ -0,0 +1,92 @@
+/*CsvFormat.hpp*/
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+
+#include "../model/include/model.h"
+
+/*
+ * printf-free rendering of the CSV sinks' lines, byte-identical to the "%d" and "%.6f" output
+ * they replace. std::to_chars is exactly rounded like glibc's printf; toolchains without the
+ * floating-point overloads fall back to snprintf for the "%.6f" fields only.
+ */
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define CSV_TO_CHARS_FLOAT 1
+#else
+#define CSV_TO_CHARS_FLOAT 0
+#endif
+
+/* Longest "%d" of an int and longest "%.6f" of a float (FLT_MAX has 39 integer digits). */
+#define CSV_INT_CHARS 11
+#define CSV_FLOAT_CHARS 48
+
+template <typename T>
+constexpr size_t csv_sample_chars()
+{
+    return std::is_floating_point_v<T> ? CSV_FLOAT_CHARS : CSV_INT_CHARS;
+}
+
+/* Upper bound of one data_chX.csv line: every sample, its separator and the newline. */
+template <typename T>
+constexpr size_t csv_window_chars()
+{
+    return MODEL_INPUT_DIM_0 * (csv_sample_chars<T>() + 1);
+}
+
+inline char *csv_put_int(char *out, int value)
+{
+    return std::to_chars(out, out + CSV_INT_CHARS, value).ptr;
+}
+
+/* Same text as "%.6f" for finite values; printf of a float argument formats the promoted double, i.e. the same value. */
+inline char *csv_put_fixed6(char *out, double value)
+{
+#if CSV_TO_CHARS_FLOAT
+    std::to_chars_result result = std::to_chars(out, out + CSV_FLOAT_CHARS, value, std::chars_format::fixed, 6);
+    if (result.ec == std::errc())
+        return result.ptr;
+#endif
+    return out + snprintf(out, CSV_FLOAT_CHARS + 1, "%.6f", value);
+}
+
+template <typename T>
+inline char *csv_put_sample(char *out, T value)
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return csv_put_fixed6(out, value);
+    else
+        return csv_put_int(out, static_cast<int>(value));
+}
+
+/* One data_chX.csv line; out needs csv_window_chars<T>() bytes. Returns the length written. */
+template <typename T>
+inline size_t format_window_csv(char *out, const T (&data)[MODEL_INPUT_DIM_0][1])
+{
+    char *p = out;
+    for (size_t k = 0; k < MODEL_INPUT_DIM_0; ++k)
+    {
+        p = csv_put_sample(p, data[k][0]);
+        *p++ = k < MODEL_INPUT_DIM_0 - 1 ? ',' : '\n';
+    }
+    return static_cast<size_t>(p - out);
+}
+
+#define CSV_RESULT_CHARS (CSV_INT_CHARS + CSV_FLOAT_CHARS + CSV_FLOAT_CHARS + 3)
+
+/* One output_chX.csv line, "index,value,time_ms" as "%d,<%d or %.6f>,%.6f\n". */
+template <typename T>
+inline size_t format_result_csv(char *out, int index, T value, double time_ms)
+{
+    char *p = csv_put_int(out, index);
+    *p++ = ',';
+    p = csv_put_sample(p, value);
+    *p++ = ',';
+    p = csv_put_fixed6(p, time_ms);
+    *p++ = '\n';
+    return static_cast<size_t>(p - out);
+}
@@ -0,0 +1,7 @@
+/*DataWriterBin.hpp*/
+
+#pragma once
+
+#include "Common.hpp"
+
+void write_data_bin(Channel &channel, const std::string &filename);
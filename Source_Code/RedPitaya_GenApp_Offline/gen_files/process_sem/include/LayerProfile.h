@@ -0,0 +1,71 @@
+/*LayerProfile.h*/
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifndef PROFILE_LAYERS
+#define PROFILE_LAYERS 0
+#endif
+#define LAYER_PROFILE_MAX_SITES 32
+#define LAYER_PROFILE_BUCKETS 32
+#define LAYER_PROFILE_NAME_LEN 48
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* One CMSIS call site in model.c; the histogram bucket b counts calls of [2^b, 2^(b+1)) ticks. */
+typedef struct
+{
+    char name[LAYER_PROFILE_NAME_LEN];
+    int line;
+    uint64_t calls;
+    uint64_t total_ticks;
+    uint64_t min_ticks;
+    uint64_t max_ticks;
+    uint64_t histogram[LAYER_PROFILE_BUCKETS];
+} layer_profile_site_t;
+
+/* Lives in the shared counters so the parent can print what each channel process measured. */
+typedef struct
+{
+    int site_count;
+    int pmu_cycles;
+    layer_profile_site_t sites[LAYER_PROFILE_MAX_SITES];
+} layer_profile_t;
+
+extern int layer_profile_use_pmu;
+
+void layer_profile_attach(layer_profile_t *profile);
+int layer_profile_register(const char *name, int line);
+void layer_profile_record(int site, uint64_t ticks);
+
+/* Cycle counter on ARM when the kernel has enabled user access to the PMU, TSC on x86, monotonic ns otherwise. */
+static inline uint64_t layer_profile_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+#if defined(__arm__) && !defined(RP_SIM)
+    if (layer_profile_use_pmu)
+    {
+        uint32_t cycles;
+        __asm__ volatile("mrc p15, 0, %0, c9, c13, 0" : "=r"(cycles));
+        return cycles;
+    }
+#endif
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -10,7 +10,11 @@
 #include <dirent.h>
 #include "Common.hpp"
 
+extern std::atomic<bool> disk_space_low;
+
 bool is_disk_space_below_threshold(const char *path, double threshold);
+bool get_available_disk_space(const char *path, double &available);
+void disk_space_monitor(const char *path, double threshold, int interval_ms);
 void set_process_affinity(int core_id);
 bool set_thread_priority(std::thread &th, int priority);
 bool set_thread_affinity(std::thread &th, int core_id);
@@ -18,5 +22,5 @@ void signal_handler(int sig);
 void print_duration(const std::string &label, uint64_t start_ns, uint64_t end_ns);
 void print_channel_stats(const shared_counters_t *counters);
 void folder_manager(const std::string &folder_path);
-bool ask_user_preferences(bool &save_data_csv, bool &save_data_dac, bool &save_output_csv, bool &save_output_dac);
+bool ask_user_preferences(bool &save_data_csv, bool &save_data_bin, bool &save_data_dac, bool &save_output_csv, bool &save_output_dac);
 void wait_for_barrier(std::atomic<int>& barrier, int total_participants);
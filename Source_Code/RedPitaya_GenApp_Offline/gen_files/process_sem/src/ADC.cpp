@@ -2,6 +2,55 @@
 
 #include "ADC.hpp"
 #include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static const int16_t *axi_buffers[2] = {nullptr, nullptr};
+static void *axi_map = MAP_FAILED;
+static size_t axi_map_size = 0;
+
+/* Maps the reserved AXI DMA region read-only so acquire_data can convert straight out of it. */
+static void map_axi_region(uint32_t start, uint32_t size)
+{
+#if ACQ_ZERO_COPY
+#ifdef RP_SIM
+    (void)start;
+    (void)size;
+    axi_buffers[RP_CH_1] = rp_SimAxiGetBuffer(RP_CH_1);
+    axi_buffers[RP_CH_2] = rp_SimAxiGetBuffer(RP_CH_2);
+#else
+    int fd = open("/dev/mem", O_RDONLY | O_SYNC);
+    if (fd < 0)
+    {
+        std::cerr << "INFO: /dev/mem unavailable, acquisition falls back to rp_AcqAxiGetDataRaw." << std::endl;
+        return;
+    }
+
+    axi_map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, start);
+    close(fd);
+    if (axi_map == MAP_FAILED)
+    {
+        std::cerr << "INFO: mmap of AXI region failed, acquisition falls back to rp_AcqAxiGetDataRaw." << std::endl;
+        return;
+    }
+
+    axi_map_size = size;
+    axi_buffers[RP_CH_1] = static_cast<const int16_t *>(axi_map);
+    axi_buffers[RP_CH_2] = static_cast<const int16_t *>(axi_map) + (size / 2) / sizeof(int16_t);
+#endif
+    if (axi_buffers[RP_CH_1] && axi_buffers[RP_CH_2])
+        std::cout << "Zero-copy acquisition enabled." << std::endl;
+#else
+    (void)start;
+    (void)size;
+#endif
+}
+
+const int16_t *axi_channel_buffer(rp_channel_t channel)
+{
+    return axi_buffers[channel];
+}
 
 
 void initialize_acq()
@@ -68,6 +117,8 @@ void initialize_acq()
         exit(-1);
     }
 
+    map_axi_region(g_adc_axi_start, g_adc_axi_size);
+
     if (rp_AcqAxiEnable(RP_CH_1, true) != RP_OK)
     {
         std::cerr << "rp_AcqAxiEnable RP_CH_1 failed!" << std::endl;
@@ -119,6 +170,9 @@ void cleanup()
     rp_AcqStopCh(RP_CH_2);
     rp_AcqAxiEnable(RP_CH_1, false);
     rp_AcqAxiEnable(RP_CH_2, false);
+    if (axi_map != MAP_FAILED)
+        munmap(axi_map, axi_map_size);
+    axi_buffers[RP_CH_1] = axi_buffers[RP_CH_2] = nullptr;
     rp_Release();
     std::cout << "Cleanup done." << std::endl;
 }
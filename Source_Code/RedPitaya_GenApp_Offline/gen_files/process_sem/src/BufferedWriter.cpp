@@ -0,0 +1,235 @@
+/*BufferedWriter.cpp*/
+
+#include "BufferedWriter.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+#define WRITER_PAGE_SIZE 4096
+
+static_assert(WRITER_BUFFER_SIZE % WRITER_PAGE_SIZE == 0, "WRITER_BUFFER_SIZE must be a whole number of pages");
+
+BufferedWriter::BufferedWriter(const std::string &path, shared_counters_t *counters)
+    : counters_(counters)
+{
+    fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0)
+        return;
+
+    for (char *&buffer : buffers_)
+    {
+        void *memory = nullptr;
+        if (posix_memalign(&memory, WRITER_PAGE_SIZE, WRITER_BUFFER_SIZE) != 0)
+        {
+            std::cerr << "Cannot allocate writer buffers for " << path << std::endl;
+            ::close(fd_);
+            fd_ = -1;
+            return;
+        }
+        buffer = static_cast<char *>(memory);
+    }
+
+    active_ = buffers_[0];
+    active_since_ = std::chrono::steady_clock::now();
+    io_thread_ = std::thread(&BufferedWriter::io_loop, this);
+}
+
+BufferedWriter::~BufferedWriter()
+{
+    close();
+    free(buffers_[0]);
+    free(buffers_[1]);
+}
+
+char *BufferedWriter::reserve(size_t size)
+{
+    if (used_ + size > WRITER_BUFFER_SIZE)
+        submit();
+    return active_ + used_;
+}
+
+void BufferedWriter::commit(size_t size)
+{
+    used_ += size;
+    offset_ += size;
+    if (used_ == WRITER_BUFFER_SIZE)
+        submit();
+}
+
+void BufferedWriter::write(const void *data, size_t size)
+{
+    const char *bytes = static_cast<const char *>(data);
+    while (size > 0)
+    {
+        size_t chunk = std::min<size_t>(size, WRITER_BUFFER_SIZE - used_);
+        std::memcpy(active_ + used_, bytes, chunk);
+        commit(chunk);
+        bytes += chunk;
+        size -= chunk;
+    }
+}
+
+void BufferedWriter::print(const char *format, ...)
+{
+    size_t room = WRITER_BUFFER_SIZE - used_;
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(active_ + used_, room, format, args);
+    va_end(args);
+
+    if (length < 0)
+        return;
+    if (static_cast<size_t>(length) >= room)
+    {
+        submit();
+        va_start(args, format);
+        length = vsnprintf(active_, WRITER_BUFFER_SIZE, format, args);
+        va_end(args);
+        if (length < 0 || length >= WRITER_BUFFER_SIZE)
+            return;
+    }
+    commit(static_cast<size_t>(length));
+}
+
+void BufferedWriter::flush_if_due()
+{
+    if (used_ > 0 && std::chrono::steady_clock::now() - active_since_ >= std::chrono::milliseconds(WRITER_FLUSH_INTERVAL_MS))
+        submit();
+}
+
+void BufferedWriter::rotate(const std::string &path)
+{
+    submit(&path);
+    offset_ = 0;
+}
+
+void BufferedWriter::submit(const std::string *next_path)
+{
+    std::unique_lock<std::mutex> lock(lock_);
+    cv_.wait(lock, [this] { return pending_ == nullptr; });
+
+    if (used_ > 0 || next_path)
+    {
+        pending_ = active_;
+        pending_size_ = used_;
+        if (next_path)
+            pending_path_ = *next_path;
+        active_ = active_ == buffers_[0] ? buffers_[1] : buffers_[0];
+        used_ = 0;
+        cv_.notify_all();
+    }
+    active_since_ = std::chrono::steady_clock::now();
+}
+
+void BufferedWriter::io_loop()
+{
+    auto last_fsync = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        char *buffer;
+        size_t size;
+        std::string next_path;
+        {
+            std::unique_lock<std::mutex> lock(lock_);
+            cv_.wait(lock, [this] { return pending_ != nullptr || stopping_; });
+            if (!pending_)
+                break;
+            buffer = pending_;
+            size = pending_size_;
+            next_path.swap(pending_path_);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        size_t written = 0;
+        while (written < size && !failed_)
+        {
+            ssize_t rc = ::write(fd_, buffer + written, size - written);
+            if (rc < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                std::cerr << "File write failed: " << strerror(errno) << std::endl;
+                failed_ = true;
+                break;
+            }
+            written += static_cast<size_t>(rc);
+        }
+
+        if (WRITER_DURABILITY == WRITER_DURABILITY_PERIODIC && !failed_ &&
+            start - last_fsync >= std::chrono::milliseconds(WRITER_FSYNC_INTERVAL_MS))
+        {
+            fdatasync(fd_);
+            last_fsync = start;
+            counters_->writer_fsyncs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        uint64_t flush_us = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        counters_->writer_bytes.fetch_add(written, std::memory_order_relaxed);
+        counters_->writer_flushes.fetch_add(1, std::memory_order_relaxed);
+        counters_->writer_flush_total_us.fetch_add(flush_us, std::memory_order_relaxed);
+        if (flush_us > counters_->writer_flush_max_us.load(std::memory_order_relaxed))
+            counters_->writer_flush_max_us.store(flush_us, std::memory_order_relaxed);
+
+        if (!next_path.empty())
+        {
+            switch_file(next_path);
+            last_fsync = std::chrono::steady_clock::now();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            pending_ = nullptr;
+        }
+        cv_.notify_all();
+    }
+}
+
+/* Runs on the I/O thread once everything meant for the old file is written. */
+void BufferedWriter::switch_file(const std::string &path)
+{
+    if (WRITER_DURABILITY != WRITER_DURABILITY_NONE && !failed_)
+    {
+        fdatasync(fd_);
+        counters_->writer_fsyncs.fetch_add(1, std::memory_order_relaxed);
+    }
+    ::close(fd_);
+
+    fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0)
+    {
+        std::cerr << "Cannot open " << path << ": " << strerror(errno) << std::endl;
+        failed_ = true;
+    }
+}
+
+void BufferedWriter::close()
+{
+    if (!io_thread_.joinable())
+        return;
+
+    submit();
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    io_thread_.join();
+
+    if (fd_ < 0)
+        return;
+
+    if (WRITER_DURABILITY != WRITER_DURABILITY_NONE && !failed_)
+    {
+        fdatasync(fd_);
+        counters_->writer_fsyncs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ::close(fd_);
+    fd_ = -1;
+}
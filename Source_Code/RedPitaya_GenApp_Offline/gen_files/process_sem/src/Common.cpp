@@ -7,3 +7,18 @@ Channel channel2;
 
 std::atomic<bool> stop_acquisition(false);
 std::atomic<bool> stop_program(false);
+
+void register_channel_sinks(Channel &channel)
+{
+    if (save_data_csv)
+        channel.data_csv_reader = channel.data_ring.add_reader(&channel.data_sem_csv);
+    if (save_data_bin)
+        channel.data_bin_reader = channel.data_ring.add_reader(&channel.data_sem_bin);
+    if (save_data_dac)
+        channel.data_dac_reader = channel.data_ring.add_reader(&channel.data_sem_dac);
+
+    if (save_output_csv)
+        channel.result_csv_reader = channel.result_ring.add_reader(&channel.result_sem_csv);
+    if (save_output_dac)
+        channel.result_dac_reader = channel.result_ring.add_reader(&channel.result_sem_dac);
+}
@@ -4,6 +4,131 @@
 #include "SystemUtils.hpp"
 #include <iostream>
 #include <chrono>
+#include <algorithm>
+#include <vector>
+#include <time.h>
+
+static constexpr double sample_period_ns = 1e9 * DECIMATION / ADC_SAMPLE_RATE;
+
+static int64_t to_ns(const timespec &ts)
+{
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/* Copies count samples starting at pos out of the DATA_SIZE ring in at most two contiguous reads. */
+static bool read_raw_block(rp_channel_t rp_channel, uint32_t pos, uint32_t count, int16_t *dst)
+{
+    uint32_t first = std::min<uint32_t>(count, DATA_SIZE - pos);
+    if (rp_AcqAxiGetDataRaw(rp_channel, pos, &first, dst) != RP_OK)
+        return false;
+
+    uint32_t second = count - first;
+    if (second == 0)
+        return true;
+    return rp_AcqAxiGetDataRaw(rp_channel, 0, &second, dst + first) == RP_OK;
+}
+
+/*
+ * Paces the write pointer polling: sleeps (TIMER_ABSTIME) until the missing samples
+ * of the next window should have been written, minus ACQ_SPIN_MARGIN_US in hybrid
+ * mode so the final stretch is still spun. Records how late each wake-up was.
+ */
+static void wait_for_samples(const timespec &poll_time, uint32_t missing, shared_counters_t &counters)
+{
+#if ACQ_POLL_POLICY == ACQ_POLL_SPIN
+    (void)poll_time;
+    (void)missing;
+    (void)counters;
+#else
+    int64_t wait_ns = static_cast<int64_t>(missing * sample_period_ns);
+#if ACQ_POLL_POLICY == ACQ_POLL_HYBRID
+    wait_ns -= ACQ_SPIN_MARGIN_US * 1000LL;
+#endif
+    if (wait_ns <= 0)
+        return;
+
+    int64_t target_ns = to_ns(poll_time) + wait_ns;
+    timespec target;
+    target.tv_sec = target_ns / 1000000000LL;
+    target.tv_nsec = target_ns % 1000000000LL;
+
+    if (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) != 0)
+        return;
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t jitter_ns = to_ns(now) - target_ns;
+    if (jitter_ns < 0)
+        jitter_ns = 0;
+
+    counters.wake_count.fetch_add(1, std::memory_order_relaxed);
+    counters.wake_jitter_total_ns.fetch_add(static_cast<uint64_t>(jitter_ns), std::memory_order_relaxed);
+    if (static_cast<uint64_t>(jitter_ns) > counters.wake_jitter_max_ns.load(std::memory_order_relaxed))
+        counters.wake_jitter_max_ns.store(static_cast<uint64_t>(jitter_ns), std::memory_order_relaxed);
+#endif
+}
+
+/*
+ * Every window goes to two queues: the model's own SPSC ring and the ring the file
+ * and DAC sinks share. Each is only limited by its own readers, so a slow sink never
+ * costs the model a window.
+ */
+static data_part_t *claim_model_slot(Channel &channel)
+{
+    data_part_t *part = channel.model_ring.claim();
+    if (!part)
+        channel.counters->model_queue_full_count.fetch_add(1, std::memory_order_relaxed);
+    return part;
+}
+
+static data_part_t *claim_sink_slot(Channel &channel)
+{
+    if (channel.data_ring.reader_count() == 0)
+        return nullptr;
+
+    data_part_t *part = channel.data_ring.claim();
+    if (!part)
+    {
+        channel.counters->sink_slot_full_count.fetch_add(1, std::memory_order_relaxed);
+        int slowest = channel.data_ring.slowest_reader();
+        if (slowest == channel.data_csv_reader)
+            channel.counters->data_drop_csv.fetch_add(1, std::memory_order_relaxed);
+        else if (slowest == channel.data_bin_reader)
+            channel.counters->data_drop_bin.fetch_add(1, std::memory_order_relaxed);
+        else if (slowest == channel.data_dac_reader)
+            channel.counters->data_drop_dac.fetch_add(1, std::memory_order_relaxed);
+    }
+    return part;
+}
+
+static void publish_model_slot(Channel &channel)
+{
+    channel.model_ring.publish();
+    channel.model_ring.notify(&channel.model_sem);
+}
+
+#if ACQ_OVERRUN_RESYNC
+/* Publishes a slot carrying no samples, only the size and time of an acquisition gap. */
+static void publish_gap_marker(Channel &channel, uint64_t seq, uint64_t lost_samples, uint64_t gap_time_ns)
+{
+    data_part_t *model_marker = claim_model_slot(channel);
+    data_part_t *sink_marker = claim_sink_slot(channel);
+
+    for (data_part_t *marker : {model_marker, sink_marker})
+    {
+        if (!marker)
+            continue;
+        marker->seq = seq;
+        marker->gap_samples = lost_samples;
+        marker->gap_time_ns = gap_time_ns;
+    }
+
+    if (model_marker)
+        publish_model_slot(channel);
+    if (sink_marker)
+        channel.data_ring.publish();
+}
+#endif
 
 void acquire_data(Channel &channel, rp_channel_t rp_channel)
 {
@@ -41,8 +166,14 @@ void acquire_data(Channel &channel, rp_channel_t rp_channel)
         std::cout << "Starting data acquisition on channel " << rp_channel + 1 << std::endl;
 
         uint32_t pw = 0;
-        constexpr uint32_t samples_per_chunk = MODEL_INPUT_DIM_0;
-        uint32_t chunk_size = samples_per_chunk;
+        /* A chunk is the hop between windows; each window also re-reads the overlap samples before its chunk. */
+        constexpr uint32_t samples_per_window = MODEL_INPUT_DIM_0;
+        constexpr uint32_t samples_per_chunk = MODEL_HOP_SIZE;
+        constexpr uint32_t overlap = samples_per_window - samples_per_chunk;
+        static_assert(MODEL_HOP_SIZE > 0 && MODEL_HOP_SIZE <= MODEL_INPUT_DIM_0, "MODEL_HOP_SIZE must be in 1..MODEL_INPUT_DIM_0");
+        constexpr uint32_t max_chunks_per_drain = std::max<uint32_t>(1, std::min<uint32_t>(ACQ_MAX_CHUNKS_PER_DRAIN, (DATA_SIZE - overlap) / samples_per_chunk));
+        std::vector<int16_t> buffer_raw(max_chunks_per_drain * samples_per_chunk + overlap);
+        const int16_t *axi_buffer = axi_channel_buffer(rp_channel);
 
         if (rp_AcqAxiGetWritePointerAtTrig(rp_channel, &pw) != RP_OK)
         {
@@ -51,10 +182,16 @@ void acquire_data(Channel &channel, rp_channel_t rp_channel)
         }
 
         uint32_t pos = pw;
+        int64_t last_poll_ns = 0;
+        uint32_t last_pending = 0;
+        bool primed = overlap == 0;
+        /* Whether the next window follows the last one handed to the model; read only without ACQ_NORMALIZE. */
+        [[maybe_unused]] bool contiguous = false;
+        uint64_t window_seq = 0;
 
         while (!stop_acquisition.load())
         {
-            if (is_disk_space_below_threshold("/", DISK_SPACE_THRESHOLD))
+            if (disk_space_low.load(std::memory_order_relaxed))
             {
                 std::cerr << "ERR: Disk space below threshold. Stopping acquisition." << std::endl;
                 stop_acquisition.store(true);
@@ -64,6 +201,9 @@ void acquire_data(Channel &channel, rp_channel_t rp_channel)
             uint32_t pwrite = 0;
             if (rp_AcqAxiGetWritePointer(rp_channel, &pwrite) == RP_OK)
             {
+                timespec poll_time;
+                clock_gettime(CLOCK_MONOTONIC, &poll_time);
+
                 int64_t distance = (pwrite >= pos) ? (pwrite - pos) : (DATA_SIZE - pos + pwrite);
 
                 if (distance < 0)
@@ -72,46 +212,140 @@ void acquire_data(Channel &channel, rp_channel_t rp_channel)
                     continue;
                 }
 
-                if (distance >= DATA_SIZE)
+                /* The pointer distance alone cannot see a lapped ring, so also count what was written since the last poll. */
+                int64_t poll_ns = to_ns(poll_time);
+                int64_t written_since = last_poll_ns ? static_cast<int64_t>((poll_ns - last_poll_ns) / sample_period_ns) : 0;
+                last_poll_ns = poll_ns;
+
+                if (distance + overlap >= DATA_SIZE || last_pending + written_since + overlap >= DATA_SIZE)
                 {
+#if ACQ_OVERRUN_RESYNC
+                    uint64_t lost = static_cast<uint64_t>(last_pending + written_since);
+                    uint64_t gap_time_ns = static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - channel.trigger_time_point).count());
+
+                    std::cerr << "WARN: Overrun on channel " << rp_channel + 1 << ", resynchronising (~" << lost << " samples lost)" << std::endl;
+                    channel.counters->overrun_count.fetch_add(1, std::memory_order_relaxed);
+                    channel.counters->lost_samples.fetch_add(lost, std::memory_order_relaxed);
+                    publish_gap_marker(channel, window_seq, lost, gap_time_ns);
+
+                    pos = pwrite;
+                    last_pending = 0;
+                    primed = overlap == 0;
+                    contiguous = false;
+                    continue;
+#else
                     std::cerr << "ERR: Overrun detected on channel " << rp_channel + 1 << " at: " << channel.counters->acquire_count.load() << std::endl;
                     stop_acquisition.store(true);
-                    return;
+                    break;
+#endif
+                }
+
+                /* The first window after the trigger or a resync needs its overlap samples before the first hop. */
+                if (!primed && distance >= overlap)
+                {
+                    pos = (pos + overlap) % DATA_SIZE;
+                    distance -= overlap;
+                    primed = true;
                 }
 
-                if (distance >= samples_per_chunk)
+                uint32_t consumed = 0;
+
+                if (primed && distance >= samples_per_chunk)
                 {
-                    int16_t buffer_raw[samples_per_chunk];
-                    if (rp_AcqAxiGetDataRaw(rp_channel, pos, &chunk_size, buffer_raw) != RP_OK)
+                    uint32_t chunks = std::min<uint32_t>(distance / samples_per_chunk, max_chunks_per_drain);
+                    uint32_t samples = chunks * samples_per_chunk;
+                    uint32_t start = pos;
+
+                    if (!axi_buffer && !read_raw_block(rp_channel, (start + DATA_SIZE - overlap) % DATA_SIZE, samples + overlap, buffer_raw.data()))
                     {
                         std::cerr << "rp_AcqAxiGetDataRaw failed on channel " << rp_channel + 1 << std::endl;
                         continue;
                     }
 
-                    auto part = std::make_shared<data_part_t>();
-                    convert_raw_data(buffer_raw, part->data, samples_per_chunk);
-
-                    pos += samples_per_chunk;
+                    pos += samples;
                     if (pos >= DATA_SIZE)
                         pos -= DATA_SIZE;
 
-                    if (save_data_csv)
+                    for (uint32_t c = 0; c < chunks; ++c)
                     {
-                        channel.data_queue_csv.push(part);
-                        sem_post(&channel.data_sem_csv);
-                    }
+                        const uint64_t seq = window_seq++;
+                        const int16_t *src = buffer_raw.data() + c * samples_per_chunk;
 
-                    if (save_data_dac)
-                    {
-                        channel.data_queue_dac.push(part);
-                        sem_post(&channel.data_sem_dac);
-                    }
+                        if (axi_buffer)
+                        {
+                            uint32_t window_pos = (start + c * samples_per_chunk + DATA_SIZE - overlap) % DATA_SIZE;
+                            if (window_pos + samples_per_window <= DATA_SIZE)
+                            {
+                                src = axi_buffer + window_pos;
+                            }
+                            else if (read_raw_block(rp_channel, window_pos, samples_per_window, buffer_raw.data()))
+                            {
+                                src = buffer_raw.data();
+                            }
+                            else
+                            {
+                                std::cerr << "rp_AcqAxiGetDataRaw failed on channel " << rp_channel + 1 << std::endl;
+                                contiguous = false;
+                                continue;
+                            }
+                        }
+
+                        data_part_t *model_part = claim_model_slot(channel);
+                        data_part_t *sink_part = claim_sink_slot(channel);
+                        data_part_t *part = model_part ? model_part : sink_part;
+                        if (!part)
+                        {
+                            contiguous = false;
+                            continue;
+                        }
 
-                    channel.model_queue.push(part);
-                    sem_post(&channel.model_sem);
+                        part->gap_samples = 0;
+                        part->seq = seq;
+                        /* When its last sample was written: the write pointer was distance samples past start at poll_time. */
+                        int64_t age_samples = distance - static_cast<int64_t>((c + 1) * samples_per_chunk);
+                        part->acq_time_ns = static_cast<uint64_t>(poll_ns - static_cast<int64_t>(age_samples * sample_period_ns));
+#if ACQ_NORMALIZE
+                        /* Only the model's private slot is normalised; the sinks keep the raw codes. */
+                        part->hop = 0;
+                        if (model_part)
+                            convert_normalize_raw_data(src, model_part->data, samples_per_window);
+                        if (model_part && sink_part)
+                        {
+                            sink_part->gap_samples = 0;
+                            sink_part->seq = seq;
+                            sink_part->acq_time_ns = model_part->acq_time_ns;
+                            sink_part->hop = 0;
+                        }
+                        if (sink_part)
+                            convert_raw_data(src, sink_part->data, samples_per_window);
+#else
+                        part->hop = contiguous ? samples_per_chunk : 0;
+                        convert_raw_data(src, part->data, samples_per_window);
+                        if (model_part && sink_part)
+                            *sink_part = *model_part;
+#endif
 
-                    channel.counters->acquire_count.fetch_add(1, std::memory_order_relaxed);
+                        if (model_part)
+                            publish_model_slot(channel);
+                        if (sink_part)
+                            channel.data_ring.publish();
+                        contiguous = model_part != nullptr;
+
+                        channel.counters->acquire_count.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    consumed = samples;
+                    channel.counters->drain_count.fetch_add(1, std::memory_order_relaxed);
+                    channel.counters->drained_chunks.fetch_add(static_cast<int>(chunks), std::memory_order_relaxed);
+                    if (static_cast<int>(chunks) > channel.counters->max_chunks_per_drain.load(std::memory_order_relaxed))
+                        channel.counters->max_chunks_per_drain.store(static_cast<int>(chunks), std::memory_order_relaxed);
                 }
+
+                uint32_t pending = static_cast<uint32_t>(distance) - consumed;
+                last_pending = pending;
+                if (pending < samples_per_chunk)
+                    wait_for_samples(poll_time, samples_per_chunk - pending, *channel.counters);
             }
         }
 
@@ -122,14 +356,8 @@ void acquire_data(Channel &channel, rp_channel_t rp_channel)
                 .count());
 
         channel.acquisition_done = true;
-
-        if (save_data_csv)
-            sem_post(&channel.data_sem_csv);
-
-        if (save_data_dac)
-            sem_post(&channel.data_sem_dac);
-
         sem_post(&channel.model_sem);
+        channel.data_ring.wake_all();
 
         std::cout << "Acquisition thread on channel " << static_cast<int>(channel.channel_id) + 1 << " exiting..." << std::endl;
     }
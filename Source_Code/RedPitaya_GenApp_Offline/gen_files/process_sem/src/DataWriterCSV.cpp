@@ -1,70 +1,73 @@
 /* DataWriterCSV.cpp */
 
 #include "DataWriterCSV.hpp"
+#include "SegmentedWriter.hpp"
+#include "CsvFormat.hpp"
 #include <iostream>
 #include <type_traits>
 
-template <typename T>
-void write_scalar(FILE *file, const T &val)
+using sample_t = std::remove_all_extents_t<input_t>;
+
+static_assert(std::is_arithmetic_v<sample_t>, "Unsupported input type for writing!");
+
+/* Renders the whole window straight into the writer's buffer. */
+static void write_window(BufferedWriter &file, const input_t &data)
 {
-    if constexpr (std::is_same_v<T, float>)
-    {
-        fprintf(file, "%.6f", val);
-    }
-    else if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t> || std::is_integral_v<T>)
-    {
-        fprintf(file, "%d", static_cast<int>(val));
-    }
-    else
-    {
-        fprintf(stderr, "Unsupported input type for writing!\n");
-        fprintf(file, "ERR");
-    }
+    char *line = file.reserve(csv_window_chars<sample_t>());
+    file.commit(format_window_csv(line, data));
 }
 
 void write_data_csv(Channel &channel, const std::string &filename)
 {
     try
     {
-        FILE *buffer_output_file = fopen(filename.c_str(), "w");
-        if (!buffer_output_file)
+        SegmentedWriter buffer_output_file(filename, channel.counters);
+        if (!buffer_output_file.is_open())
         {
             std::cerr << "Error opening buffer output file.\n";
             return;
         }
 
+        const int reader = channel.data_csv_reader;
+        const data_part_t *part = nullptr;
+
         while (true)
         {
-            if (sem_wait(&channel.data_sem_csv) != 0)
+            if (!channel.data_ring.wait(reader))
             {
-                if (errno == EINTR && stop_program.load())
+                if (stop_program.load())
                     break;
                 continue;
             }
 
-            while (!channel.data_queue_csv.empty())
+            while ((part = channel.data_ring.peek(reader)) != nullptr)
             {
-                std::shared_ptr<data_part_t> part = channel.data_queue_csv.front();
-                channel.data_queue_csv.pop();
-
-                for (size_t k = 0; k < MODEL_INPUT_DIM_0; k++)
+                if (part->gap_samples)
                 {
-                    write_scalar(buffer_output_file, part->data[k][0]);
-                    if (k < MODEL_INPUT_DIM_0 - 1)
-                        fprintf(buffer_output_file, ",");
+                    buffer_output_file.print("# gap,%llu,%llu\n",
+                            static_cast<unsigned long long>(part->gap_samples),
+                            static_cast<unsigned long long>(part->gap_time_ns));
+                    channel.data_ring.consume(reader);
+                    continue;
                 }
 
-                fprintf(buffer_output_file, "\n");
-                fflush(buffer_output_file);
+                /* Overlapping windows: tell readers the hop and where the file starts, see plot.py. */
+                if (buffer_output_file.begin_record(part->seq, buffer_output_file.since_trigger(part->acq_time_ns)) &&
+                    MODEL_HOP_SIZE < MODEL_INPUT_DIM_0)
+                    buffer_output_file.print("# hop,%u,%llu\n", static_cast<unsigned>(MODEL_HOP_SIZE),
+                            static_cast<unsigned long long>(part->seq));
+                write_window(buffer_output_file, part->data);
 
+                channel.data_ring.consume(reader);
                 channel.counters->write_count_csv.fetch_add(1, std::memory_order_relaxed);
             }
+            buffer_output_file.flush_if_due();
 
-            if (channel.acquisition_done && channel.data_queue_csv.empty())
+            if (channel.acquisition_done && channel.data_ring.empty(reader))
                 break;
         }
 
-        fclose(buffer_output_file);
+        buffer_output_file.close();
         std::cout << "Data writing on CSV thread on channel " << static_cast<int>(channel.channel_id) + 1 << " exiting..." << std::endl;
     }
     catch (const std::exception &e)
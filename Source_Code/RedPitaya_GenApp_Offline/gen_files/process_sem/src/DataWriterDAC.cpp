@@ -2,27 +2,34 @@
 
 #include "DataWriterDAC.hpp"
 #include <iostream>
+#include <algorithm>
 
 void write_data_dac(Channel &channel, rp_channel_t rp_channel)
 {
     try
     {
+        const int reader = channel.data_dac_reader;
+        const data_part_t *part = nullptr;
+
         while (true)
         {
-            if (sem_wait(&channel.data_sem_dac) != 0)
+            if (!channel.data_ring.wait(reader))
             {
-                if (errno == EINTR && stop_program.load())
+                if (stop_program.load())
                     break;
                 continue;
             }
 
-            if (stop_program.load() && channel.data_queue_dac.empty())
+            if (stop_program.load() && channel.data_ring.empty(reader))
                 break;
 
-            while (!channel.data_queue_dac.empty())
+            while ((part = channel.data_ring.peek(reader)) != nullptr)
             {
-                std::shared_ptr<data_part_t> part = channel.data_queue_dac.front();
-                channel.data_queue_dac.pop();
+                if (part->gap_samples)
+                {
+                    channel.data_ring.consume(reader);
+                    continue;
+                }
 
                 for (size_t k = 0; k < MODEL_INPUT_DIM_0; k++)
                 {
@@ -31,10 +38,11 @@ void write_data_dac(Channel &channel, rp_channel_t rp_channel)
                     rp_GenAmp(rp_channel, voltage);
                 }
 
+                channel.data_ring.consume(reader);
                 channel.counters->write_count_dac.fetch_add(1, std::memory_order_relaxed);
             }
 
-            if (channel.acquisition_done && channel.data_queue_dac.empty())
+            if (channel.acquisition_done && channel.data_ring.empty(reader))
                 break;
         }
 
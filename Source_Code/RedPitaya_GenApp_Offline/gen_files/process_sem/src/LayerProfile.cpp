@@ -0,0 +1,137 @@
+/*LayerProfile.cpp*/
+
+#include "LayerProfile.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <sstream>
+
+int layer_profile_use_pmu = 0;
+static layer_profile_t *active_profile = nullptr;
+
+static bool pmu_user_access()
+{
+#if defined(__arm__) && !defined(RP_SIM)
+    uint32_t userenr = 0;
+    __asm__ volatile("mrc p15, 0, %0, c9, c14, 0" : "=r"(userenr));
+    if (!(userenr & 1))
+        return false;
+
+    uint32_t enabled = 0;
+    __asm__ volatile("mrc p15, 0, %0, c9, c12, 1" : "=r"(enabled));
+    return (enabled >> 31) & 1;
+#else
+    return false;
+#endif
+}
+
+void layer_profile_attach(layer_profile_t *profile)
+{
+    layer_profile_use_pmu = pmu_user_access();
+    profile->pmu_cycles = layer_profile_use_pmu;
+    active_profile = profile;
+}
+
+int layer_profile_register(const char *name, int line)
+{
+    if (!active_profile)
+        return -1;
+
+    for (int i = 0; i < active_profile->site_count; ++i)
+    {
+        if (active_profile->sites[i].line == line && std::strcmp(active_profile->sites[i].name, name) == 0)
+            return i;
+    }
+
+    if (active_profile->site_count == LAYER_PROFILE_MAX_SITES)
+        return -1;
+
+    layer_profile_site_t &site = active_profile->sites[active_profile->site_count];
+    std::strncpy(site.name, name, LAYER_PROFILE_NAME_LEN - 1);
+    site.line = line;
+    site.min_ticks = UINT64_MAX;
+    return active_profile->site_count++;
+}
+
+void layer_profile_record(int site_id, uint64_t ticks)
+{
+    if (site_id < 0 || !active_profile)
+        return;
+
+    if (active_profile->pmu_cycles)
+        ticks &= 0xffffffffULL;
+
+    layer_profile_site_t &site = active_profile->sites[site_id];
+    site.calls++;
+    site.total_ticks += ticks;
+    if (ticks < site.min_ticks)
+        site.min_ticks = ticks;
+    if (ticks > site.max_ticks)
+        site.max_ticks = ticks;
+
+    int bucket = ticks ? 63 - __builtin_clzll(ticks) : 0;
+    if (bucket >= LAYER_PROFILE_BUCKETS)
+        bucket = LAYER_PROFILE_BUCKETS - 1;
+    site.histogram[bucket]++;
+}
+
+/* Upper bound of the histogram bucket holding the given fraction of calls. */
+static uint64_t percentile_bound(const layer_profile_site_t &site, double fraction)
+{
+    uint64_t target = static_cast<uint64_t>(site.calls * fraction);
+    uint64_t seen = 0;
+    for (int b = 0; b < LAYER_PROFILE_BUCKETS; ++b)
+    {
+        seen += site.histogram[b];
+        if (seen > target)
+            return 2ULL << b;
+    }
+    return site.max_ticks;
+}
+
+void print_layer_profile(const layer_profile_t &profile, const char *label)
+{
+    if (profile.site_count == 0)
+        return;
+
+#if defined(__x86_64__) || defined(__i386__)
+    const char *unit = "TSC ticks";
+#else
+    const char *unit = profile.pmu_cycles ? "cycles" : "ns";
+#endif
+
+    uint64_t total = 0;
+    for (int i = 0; i < profile.site_count; ++i)
+        total += profile.sites[i].total_ticks;
+
+    std::cout << "\nLayer profile " << label << " (" << unit << " per call, p50/p99 are histogram upper bounds):\n";
+    std::cout << std::left << std::setw(52) << "call site" << std::right
+              << std::setw(10) << "calls" << std::setw(12) << "mean" << std::setw(12) << "min"
+              << std::setw(12) << "p50<=" << std::setw(12) << "p99<=" << std::setw(12) << "max"
+              << std::setw(9) << "share" << '\n';
+
+    for (int i = 0; i < profile.site_count; ++i)
+    {
+        const layer_profile_site_t &site = profile.sites[i];
+        if (site.calls == 0)
+            continue;
+
+        std::ostringstream where;
+        where << site.name << ":" << site.line;
+        std::cout << std::left << std::setw(52) << where.str() << std::right
+                  << std::setw(10) << site.calls
+                  << std::setw(12) << site.total_ticks / site.calls
+                  << std::setw(12) << site.min_ticks
+                  << std::setw(12) << percentile_bound(site, 0.50)
+                  << std::setw(12) << percentile_bound(site, 0.99)
+                  << std::setw(12) << site.max_ticks
+                  << std::setw(8) << std::fixed << std::setprecision(1)
+                  << (total ? 100.0 * site.total_ticks / total : 0.0) << "%" << std::defaultfloat << '\n';
+    }
+}
+
+void print_layer_profile(const shared_counters_t *counters)
+{
+    print_layer_profile(counters[0].layer_profile, "CH1");
+    print_layer_profile(counters[1].layer_profile, "CH2");
+}
@@ -1,32 +1,26 @@
 /*ModelWriterCSV.cpp*/
 
 #include "ModelWriterCSV.hpp"
+#include "SegmentedWriter.hpp"
+#include "CsvFormat.hpp"
 #include <iostream>
 #include <type_traits>
 
 template <typename T>
-void write_output(FILE *file, int index, const T &value, double time_ms)
+void write_output(BufferedWriter &file, int index, const T &value, double time_ms)
 {
-    if constexpr (std::is_integral<T>::value)
-    {
-        fprintf(file, "%d,%d,%.6f\n", index, static_cast<int>(value), time_ms);
-    }
-    else if constexpr (std::is_floating_point<T>::value)
-    {
-        fprintf(file, "%d,%.6f,%.6f\n", index, value, time_ms);
-    }
-    else
-    {
-        fprintf(file, "%d,%d,%.6f\n", index, static_cast<int>(value), time_ms);
-    }
+    static_assert(std::is_arithmetic<T>::value, "Unsupported output type for writing!");
+
+    char *line = file.reserve(CSV_RESULT_CHARS);
+    file.commit(format_result_csv(line, index, value, time_ms));
 }
 
 void log_results_csv(Channel &channel, const std::string &filename)
 {
     try
     {
-        FILE *output_file = fopen(filename.c_str(), "w");
-        if (!output_file)
+        SegmentedWriter output_file(filename, channel.counters);
+        if (!output_file.is_open())
         {
             std::cerr << "Error opening output file: " << filename << "\n";
             return;
@@ -34,32 +28,44 @@ void log_results_csv(Channel &channel, const std::string &filename)
 
         int output_index = 1;
 
+        const int reader = channel.result_csv_reader;
+        const model_result_t *result = nullptr;
+
         while (true)
         {
-            if (sem_wait(&channel.result_sem_csv) != 0)
+            if (!channel.result_ring.wait(reader))
             {
-                if (errno == EINTR && stop_program.load())
+                if (stop_program.load())
                     break;
                 continue;
             }
 
-            if (stop_program.load() && channel.result_buffer_csv.empty())
+            if (stop_program.load() && channel.result_ring.empty(reader))
                 break;
 
-            while (!channel.result_buffer_csv.empty())
+            while ((result = channel.result_ring.peek(reader)) != nullptr)
             {
-                const model_result_t &result = channel.result_buffer_csv.front();
-                write_output(output_file, output_index++, result.output[0], result.computation_time);
-                fflush(output_file);
-                channel.result_buffer_csv.pop_front();
+                if (result->gap_samples)
+                {
+                    output_file.print("# gap,%llu,%llu\n",
+                            static_cast<unsigned long long>(result->gap_samples),
+                            static_cast<unsigned long long>(result->gap_time_ns));
+                    channel.result_ring.consume(reader);
+                    continue;
+                }
+
+                output_file.begin_record(result->seq, output_file.since_trigger(result->acq_time_ns));
+                write_output(output_file, output_index++, result->output[0], result->computation_time);
+                channel.result_ring.consume(reader);
                 channel.counters->log_count_csv.fetch_add(1, std::memory_order_relaxed);
             }
+            output_file.flush_if_due();
 
-            if (channel.processing_done && channel.result_buffer_csv.empty())
+            if (channel.processing_done && channel.result_ring.empty(reader))
                 break;
         }
 
-        fclose(output_file);
+        output_file.close();
         std::cout << "Logging inference results on CSV thread on channel " << static_cast<int>(channel.channel_id) + 1 << " exiting..." << std::endl;
     }
     catch (const std::exception &e)
@@ -2,34 +2,43 @@
 
 #include "ModelWriterDAC.hpp"
 #include <iostream>
+#include <algorithm>
 
 void log_results_dac(Channel &channel, rp_channel_t rp_channel)
 {
     try
     {
+        const int reader = channel.result_dac_reader;
+        const model_result_t *result = nullptr;
+
         while (true)
         {
-            if (sem_wait(&channel.result_sem_dac) != 0)
+            if (!channel.result_ring.wait(reader))
             {
-                if (errno == EINTR && stop_program.load())
+                if (stop_program.load())
                     break;
                 continue;
             }
 
-            if (stop_program.load() && channel.result_buffer_dac.empty())
+            if (stop_program.load() && channel.result_ring.empty(reader))
                 break;
 
-            while (!channel.result_buffer_dac.empty())
+            while ((result = channel.result_ring.peek(reader)) != nullptr)
             {
-                const model_result_t &result = channel.result_buffer_dac.front();
-                float voltage = OutputToVoltage(result.output[0]);
+                if (result->gap_samples)
+                {
+                    channel.result_ring.consume(reader);
+                    continue;
+                }
+
+                float voltage = OutputToVoltage(result->output[0]);
                 voltage = std::clamp(voltage, -1.0f, 1.0f);
                 rp_GenAmp(rp_channel, voltage);
-                channel.result_buffer_dac.pop_front();
+                channel.result_ring.consume(reader);
                 channel.counters->log_count_dac.fetch_add(1, std::memory_order_relaxed);
             }
 
-            if (channel.processing_done && channel.result_buffer_dac.empty())
+            if (channel.processing_done && channel.result_ring.empty(reader))
                 break;
         }
 
@@ -0,0 +1,206 @@
+/*SegmentedWriter.cpp*/
+
+#include "SegmentedWriter.hpp"
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <time.h>
+
+/* Closed segments of every writer in this process, oldest first. */
+struct closed_segment_t
+{
+    std::string path;
+    shared_counters_t *counters;
+};
+
+static std::mutex closed_lock;
+static std::deque<closed_segment_t> closed_segments;
+
+static void retire_segment(const std::string &path, shared_counters_t *counters)
+{
+    std::lock_guard<std::mutex> lock(closed_lock);
+    closed_segments.push_back({path, counters});
+}
+
+bool delete_oldest_segment()
+{
+    closed_segment_t oldest;
+    {
+        std::lock_guard<std::mutex> lock(closed_lock);
+        if (closed_segments.empty())
+            return false;
+        oldest = closed_segments.front();
+        closed_segments.pop_front();
+    }
+
+    std::error_code error;
+    if (!std::filesystem::remove(oldest.path, error))
+    {
+        std::cerr << "Failed to delete segment: " << oldest.path << " - " << error.message() << std::endl;
+        return true;
+    }
+    std::cerr << "WARN: Disk space low, deleted oldest segment " << oldest.path << std::endl;
+    oldest.counters->segments_deleted.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+/* Segment number of name = stem.NNNNNN.extension, or -1. */
+static long segment_number(const std::string &name, const std::string &stem, const std::string &extension)
+{
+    if (name.size() < stem.size() + extension.size() + 7 || name.compare(0, stem.size(), stem) != 0 ||
+        name[stem.size()] != '.' || name.compare(name.size() - extension.size(), extension.size(), extension) != 0)
+        return -1;
+
+    std::string digits = name.substr(stem.size() + 1, name.size() - stem.size() - 1 - extension.size());
+    if (digits.size() < 6 || !std::all_of(digits.begin(), digits.end(), [](unsigned char c) { return std::isdigit(c); }))
+        return -1;
+    return std::stol(digits);
+}
+
+bool is_segment_file(const std::filesystem::path &path)
+{
+    std::string extension = path.extension().string();
+    if (extension == ".idx")
+        return true;
+
+    std::string stem = path.stem().string();
+    size_t dot = stem.rfind('.');
+    return dot != std::string::npos && segment_number(path.filename().string(), stem.substr(0, dot), extension) >= 0;
+}
+
+SegmentedWriter::segment_files_t SegmentedWriter::find_segments(const std::string &path)
+{
+    namespace fs = std::filesystem;
+
+    segment_files_t files;
+    files.path = path;
+    if (!WRITER_SEGMENTED)
+        return files;
+
+    fs::path file(path);
+    files.stem = file.stem().string();
+    files.extension = file.extension().string();
+
+    std::vector<std::pair<long, std::string>> found;
+    std::error_code error;
+    fs::path dir = file.has_parent_path() ? file.parent_path() : fs::path(".");
+    for (const auto &entry : fs::directory_iterator(dir, error))
+    {
+        long number = segment_number(entry.path().filename().string(), files.stem, files.extension);
+        if (number >= 0)
+            found.emplace_back(number, entry.path().string());
+    }
+
+    std::sort(found.begin(), found.end());
+    for (const auto &segment : found)
+        files.existing.push_back(segment.second);
+    files.next = found.empty() ? 0 : static_cast<unsigned>(found.back().first + 1);
+    return files;
+}
+
+std::string SegmentedWriter::segment_path(const segment_files_t &files, unsigned number)
+{
+    if (!WRITER_SEGMENTED)
+        return files.path;
+
+    char digits[16];
+    snprintf(digits, sizeof(digits), ".%06u", number);
+    std::filesystem::path file(files.path);
+    return (file.parent_path() / (files.stem + digits + files.extension)).string();
+}
+
+SegmentedWriter::SegmentedWriter(const std::string &path, shared_counters_t *counters)
+    : SegmentedWriter(find_segments(path), counters)
+{
+}
+
+SegmentedWriter::SegmentedWriter(segment_files_t files, shared_counters_t *counters)
+    : BufferedWriter(segment_path(files, files.next), counters), files_(std::move(files)), counters_(counters), segment_(files_.next)
+{
+    for (const std::string &existing : files_.existing)
+        retire_segment(existing, counters_);
+}
+
+SegmentedWriter::~SegmentedWriter()
+{
+    close();
+}
+
+uint64_t SegmentedWriter::since_trigger(uint64_t acq_time_ns) const
+{
+    uint64_t trigger_ns = counters_->trigger_time_ns.load(std::memory_order_relaxed);
+    return acq_time_ns > trigger_ns ? acq_time_ns - trigger_ns : 0;
+}
+
+bool SegmentedWriter::begin_record(uint64_t seq, uint64_t time_ns)
+{
+    if (!started_)
+    {
+        started_ = true;
+    }
+    else if (!WRITER_SEGMENTED)
+    {
+        return false;
+    }
+    else if ((WRITER_SEGMENT_MB > 0 && offset() >= WRITER_SEGMENT_MB * 1024ULL * 1024ULL) ||
+             (WRITER_SEGMENT_SECONDS > 0 && time_ns >= segment_start_ns_ + WRITER_SEGMENT_SECONDS * 1000000000ULL))
+    {
+        retire_segment(segment_path(files_, segment_), counters_);
+        rotate(segment_path(files_, ++segment_));
+    }
+    else
+    {
+        if (time_ns >= last_index_ns_ + WRITER_INDEX_INTERVAL_MS * 1000000ULL)
+            add_index_entry(seq, time_ns);
+        return false;
+    }
+
+    if (WRITER_SEGMENTED)
+        counters_->segments_opened.fetch_add(1, std::memory_order_relaxed);
+    segment_start_ns_ = time_ns;
+    add_index_entry(seq, time_ns);
+    return true;
+}
+
+void SegmentedWriter::add_index_entry(uint64_t seq, uint64_t time_ns)
+{
+    if (!WRITER_SEGMENTED)
+        return;
+
+    if (!index_)
+    {
+        index_ = std::fopen((files_.path + ".idx").c_str(), "a");
+        if (!index_)
+        {
+            std::cerr << "Cannot open segment index " << files_.path << ".idx" << std::endl;
+            return;
+        }
+
+        timespec mono, unix_time;
+        clock_gettime(CLOCK_MONOTONIC, &mono);
+        clock_gettime(CLOCK_REALTIME, &unix_time);
+        int64_t mono_to_unix = (static_cast<int64_t>(unix_time.tv_sec) - mono.tv_sec) * 1000000000LL + (unix_time.tv_nsec - mono.tv_nsec);
+        uint64_t trigger_ns = counters_->trigger_time_ns.load(std::memory_order_relaxed);
+
+        if (std::ftell(index_) == 0)
+            std::fprintf(index_, "# segment,seq,time_ns,offset\n");
+        std::fprintf(index_, "# trigger,%lld\n", static_cast<long long>(trigger_ns + mono_to_unix));
+    }
+
+    std::fprintf(index_, "%06u,%llu,%llu,%llu\n", segment_, static_cast<unsigned long long>(seq),
+                 static_cast<unsigned long long>(time_ns), static_cast<unsigned long long>(offset()));
+    std::fflush(index_);
+    last_index_ns_ = time_ns;
+}
+
+void SegmentedWriter::close()
+{
+    BufferedWriter::close();
+    if (index_)
+    {
+        std::fclose(index_);
+        index_ = nullptr;
+    }
+}
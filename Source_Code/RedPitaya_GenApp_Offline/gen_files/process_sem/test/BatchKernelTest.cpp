@@ -0,0 +1,130 @@
+/*BatchKernelTest.cpp*/
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "arm_nnfunctions.h"
+
+struct conv_case_t
+{
+    uint16_t dim_in_x, dim_in_y, ch_in, ch_out;
+    uint16_t kernel_x, kernel_y, padding_x, padding_y, stride_x, stride_y;
+    uint16_t batch;
+};
+
+struct fc_case_t
+{
+    uint16_t dim_vec, num_of_rows, batch;
+};
+
+static void fill(std::vector<q15_t> &values, std::mt19937 &rng, int limit)
+{
+    std::uniform_int_distribution<int> value(-limit, limit - 1);
+    for (q15_t &v : values)
+        v = static_cast<q15_t>(value(rng));
+}
+
+/* Convolves a batch of random images at once and each image on its own; every output must match. */
+static size_t run_conv_case(const conv_case_t &c, std::mt19937 &rng)
+{
+    const uint16_t dim_out_x = (c.dim_in_x + 2 * c.padding_x - c.kernel_x) / c.stride_x + 1;
+    const uint16_t dim_out_y = (c.dim_in_y + 2 * c.padding_y - c.kernel_y) / c.stride_y + 1;
+    const size_t col_len = static_cast<size_t>(c.ch_in) * c.kernel_x * c.kernel_y;
+    const size_t in_size = static_cast<size_t>(c.dim_in_x) * c.dim_in_y * c.ch_in;
+    const size_t out_size = static_cast<size_t>(dim_out_x) * dim_out_y * c.ch_out;
+
+    std::vector<q15_t> images(in_size * c.batch), wt(col_len * c.ch_out), bias(c.ch_out);
+    fill(images, rng, 8192);
+    fill(wt, rng, 512);
+    fill(bias, rng, 512);
+
+    std::vector<q15_t> batched(out_size * c.batch), single(out_size * c.batch);
+    std::vector<q15_t> batch_buffer(col_len * c.batch), buffer(col_len);
+
+    arm_convolve_HWC_q15_basic_nonsquare_batch(images.data(), c.dim_in_x, c.dim_in_y, c.ch_in, wt.data(), c.ch_out,
+                                               c.kernel_x, c.kernel_y, c.padding_x, c.padding_y, c.stride_x, c.stride_y,
+                                               bias.data(), 2, 9, batched.data(), dim_out_x, dim_out_y,
+                                               batch_buffer.data(), c.batch);
+    for (uint16_t b = 0; b < c.batch; ++b)
+        arm_convolve_HWC_q15_basic_nonsquare(images.data() + b * in_size, c.dim_in_x, c.dim_in_y, c.ch_in, wt.data(),
+                                             c.ch_out, c.kernel_x, c.kernel_y, c.padding_x, c.padding_y, c.stride_x,
+                                             c.stride_y, bias.data(), 2, 9, single.data() + b * out_size, dim_out_x,
+                                             dim_out_y, buffer.data(), nullptr);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < batched.size(); ++i)
+        mismatches += batched[i] != single[i];
+    return mismatches;
+}
+
+/* Same for the fully-connected layer: one matrix-matrix call against one matrix-vector call per vector. */
+static size_t run_fc_case(const fc_case_t &c, std::mt19937 &rng)
+{
+    std::vector<q15_t> vectors(static_cast<size_t>(c.dim_vec) * c.batch);
+    std::vector<q15_t> weights(static_cast<size_t>(c.dim_vec) * c.num_of_rows), bias(c.num_of_rows);
+    fill(vectors, rng, 8192);
+    fill(weights, rng, 512);
+    fill(bias, rng, 512);
+
+    std::vector<q15_t> batched(static_cast<size_t>(c.num_of_rows) * c.batch);
+    std::vector<q15_t> single(batched.size());
+    std::vector<q15_t> vec_buffer(c.dim_vec);
+
+    arm_fully_connected_q15_batch(vectors.data(), weights.data(), c.dim_vec, c.num_of_rows, 2, 9, bias.data(),
+                                  batched.data(), c.batch);
+    for (uint16_t b = 0; b < c.batch; ++b)
+        arm_fully_connected_q15(vectors.data() + b * c.dim_vec, weights.data(), c.dim_vec, c.num_of_rows, 2, 9,
+                                bias.data(), single.data() + b * c.num_of_rows, vec_buffer.data());
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < batched.size(); ++i)
+        mismatches += batched[i] != single[i];
+    return mismatches;
+}
+
+int main()
+{
+    const conv_case_t conv_cases[] = {
+        /* dim_x, dim_y, ch_in, ch_out, k_x, k_y, pad_x, pad_y, stride_x, stride_y, batch */
+        {128, 1, 1, 8, 3, 1, 0, 0, 1, 1, 1},
+        {128, 1, 1, 8, 3, 1, 1, 0, 1, 1, 2},
+        {128, 1, 2, 4, 5, 1, 2, 0, 1, 1, 3},
+        {128, 1, 1, 8, 4, 1, 1, 0, 2, 1, 8},
+        {64, 1, 3, 5, 7, 1, 3, 0, 3, 1, 5},
+        {32, 3, 2, 4, 3, 3, 1, 1, 2, 1, 4},
+        {16, 16, 1, 3, 3, 3, 1, 1, 1, 1, 7},
+    };
+    const fc_case_t fc_cases[] = {
+        /* dim_vec, num_of_rows, batch */
+        {128, 2, 1},
+        {128, 16, 2},
+        {64, 10, 8},
+        {63, 7, 3},
+        {5, 3, 5},
+        {256, 33, 6},
+    };
+
+    std::mt19937 rng(1414);
+    size_t failed = 0;
+    for (const conv_case_t &c : conv_cases)
+    {
+        size_t mismatches = run_conv_case(c, rng);
+        std::cout << "conv in " << c.dim_in_x << "x" << c.dim_in_y << "x" << c.ch_in << " kernel " << c.kernel_x << "x"
+                  << c.kernel_y << " pad " << c.padding_x << " stride " << c.stride_x << " batch " << c.batch << ": "
+                  << mismatches << " mismatches\n";
+        failed += mismatches != 0;
+    }
+    for (const fc_case_t &c : fc_cases)
+    {
+        size_t mismatches = run_fc_case(c, rng);
+        std::cout << "fully connected " << c.dim_vec << " -> " << c.num_of_rows << " batch " << c.batch << ": "
+                  << mismatches << " mismatches\n";
+        failed += mismatches != 0;
+    }
+
+    const size_t total = sizeof(conv_cases) / sizeof(conv_cases[0]) + sizeof(fc_cases) / sizeof(fc_cases[0]);
+    std::cout << (failed ? "FAIL" : "OK") << ": batched vs per-window kernels, " << total << " cases\n";
+    return failed ? 1 : 0;
+}
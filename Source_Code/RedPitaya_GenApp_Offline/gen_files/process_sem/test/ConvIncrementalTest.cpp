@@ -0,0 +1,102 @@
+/*ConvIncrementalTest.cpp*/
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "arm_nnfunctions.h"
+
+#define TEST_STEPS 48
+
+struct conv_case_t
+{
+    uint16_t dim_in_x, dim_in_y, ch_in, ch_out;
+    uint16_t kernel_x, kernel_y, padding_x, padding_y, stride_x, stride_y;
+    uint16_t shift_x;
+};
+
+/*
+ * Slides a window along a random signal by shift_x columns per step and keeps one
+ * output updated with the incremental kernel. After every step it must equal the
+ * full convolution of the new window. Shifts that are 0, not a multiple of the
+ * stride or not smaller than the window take the recompute-everything path.
+ */
+static size_t run_case(const conv_case_t &c, std::mt19937 &rng)
+{
+    const uint16_t dim_out_x = (c.dim_in_x + 2 * c.padding_x - c.kernel_x) / c.stride_x + 1;
+    const uint16_t dim_out_y = (c.dim_in_y + 2 * c.padding_y - c.kernel_y) / c.stride_y + 1;
+    const size_t col_len = static_cast<size_t>(c.ch_in) * c.kernel_x * c.kernel_y;
+    const size_t row_len = (static_cast<size_t>(TEST_STEPS - 1) * c.shift_x + c.dim_in_x) * c.ch_in;
+
+    std::uniform_int_distribution<int> sample(-8192, 8191);
+    std::uniform_int_distribution<int> weight(-512, 511);
+
+    /* dim_in_y rows of one long signal; window w starts at column w * shift_x of every row. */
+    std::vector<q15_t> signal(row_len * c.dim_in_y);
+    for (q15_t &value : signal)
+        value = static_cast<q15_t>(sample(rng));
+    std::vector<q15_t> wt(col_len * c.ch_out), bias(c.ch_out);
+    for (q15_t &value : wt)
+        value = static_cast<q15_t>(weight(rng));
+    for (q15_t &value : bias)
+        value = static_cast<q15_t>(weight(rng));
+
+    const size_t in_size = static_cast<size_t>(c.dim_in_x) * c.dim_in_y * c.ch_in;
+    const size_t out_size = static_cast<size_t>(dim_out_x) * dim_out_y * c.ch_out;
+    std::vector<q15_t> window(in_size), full(out_size), incremental(out_size), bufferA(col_len);
+
+    size_t mismatches = 0;
+    for (int step = 0; step < TEST_STEPS; ++step)
+    {
+        const size_t start = static_cast<size_t>(step) * c.shift_x;
+        for (uint16_t y = 0; y < c.dim_in_y; ++y)
+            std::copy_n(signal.begin() + y * row_len + start * c.ch_in, static_cast<size_t>(c.dim_in_x) * c.ch_in,
+                        window.begin() + static_cast<size_t>(y) * c.dim_in_x * c.ch_in);
+
+        arm_convolve_HWC_q15_basic_nonsquare(window.data(), c.dim_in_x, c.dim_in_y, c.ch_in, wt.data(), c.ch_out,
+                                             c.kernel_x, c.kernel_y, c.padding_x, c.padding_y, c.stride_x, c.stride_y,
+                                             bias.data(), 2, 9, full.data(), dim_out_x, dim_out_y, bufferA.data(), nullptr);
+        /* The first window has no previous output to reuse. */
+        arm_convolve_HWC_q15_basic_nonsquare_incremental(window.data(), c.dim_in_x, c.dim_in_y, c.ch_in, wt.data(), c.ch_out,
+                                                         c.kernel_x, c.kernel_y, c.padding_x, c.padding_y, c.stride_x,
+                                                         c.stride_y, bias.data(), 2, 9, incremental.data(), dim_out_x,
+                                                         dim_out_y, bufferA.data(), step == 0 ? 0 : c.shift_x);
+
+        for (size_t i = 0; i < out_size; ++i)
+            mismatches += full[i] != incremental[i];
+    }
+    return mismatches;
+}
+
+int main()
+{
+    const conv_case_t cases[] = {
+        /* dim_x, dim_y, ch_in, ch_out, k_x, k_y, pad_x, pad_y, stride_x, stride_y, shift_x */
+        {128, 1, 1, 8, 3, 1, 0, 0, 1, 1, 1},
+        {128, 1, 1, 8, 3, 1, 1, 0, 1, 1, 16},
+        {128, 1, 2, 4, 5, 1, 2, 0, 1, 1, 64},
+        {128, 1, 1, 8, 4, 1, 0, 0, 2, 1, 2},
+        {128, 1, 1, 8, 4, 1, 1, 0, 2, 1, 32},
+        {128, 1, 3, 6, 7, 1, 3, 0, 3, 1, 9},
+        {128, 1, 1, 8, 3, 1, 1, 0, 2, 1, 3},   /* not a multiple of the stride */
+        {128, 1, 1, 8, 3, 1, 0, 0, 1, 1, 128}, /* no overlap */
+        {64, 3, 2, 4, 3, 3, 1, 1, 2, 1, 4},
+    };
+
+    std::mt19937 rng(2024);
+    size_t failed = 0;
+    for (const conv_case_t &c : cases)
+    {
+        size_t mismatches = run_case(c, rng);
+        std::cout << "in " << c.dim_in_x << "x" << c.dim_in_y << "x" << c.ch_in << " kernel " << c.kernel_x << "x"
+                  << c.kernel_y << " pad " << c.padding_x << " stride " << c.stride_x << " shift " << c.shift_x << ": "
+                  << mismatches << " mismatches\n";
+        failed += mismatches != 0;
+    }
+
+    std::cout << (failed ? "FAIL" : "OK") << ": incremental vs full convolution, " << sizeof(cases) / sizeof(cases[0])
+              << " cases x " << TEST_STEPS << " steps\n";
+    return failed ? 1 : 0;
+}
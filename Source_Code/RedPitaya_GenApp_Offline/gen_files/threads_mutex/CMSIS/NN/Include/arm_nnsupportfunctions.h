@@ -617,6 +617,132 @@ __STATIC_FORCEINLINE q31_t arm_nn_read_q15x2(const q15_t *in_q15)
     return (val);
 }
 
+#if defined(ARM_MATH_NEON)
+/**
+  @brief         Q15 dot product added to an accumulator, NEON replacement for an __SMLAD loop.
+  @param[in]     pA       pointer to first vector
+  @param[in]     pB       pointer to second vector
+  @param[in]     len      number of elements
+  @param[in]     sum      accumulator start value
+  @return        sum + dot(pA, pB), wrapping on overflow exactly like __SMLAD
+ */
+__STATIC_FORCEINLINE q31_t arm_nn_dot_q15_neon(const q15_t *pA, const q15_t *pB, int32_t len, q31_t sum)
+{
+    int32x4_t acc0 = vdupq_n_s32(0);
+    int32x4_t acc1 = vdupq_n_s32(0);
+    int32_t i = 0;
+
+    for (; i + 8 <= len; i += 8)
+    {
+        int16x8_t inA = vld1q_s16(pA + i);
+        int16x8_t inB = vld1q_s16(pB + i);
+        acc0 = vmlal_s16(acc0, vget_low_s16(inA), vget_low_s16(inB));
+        acc1 = vmlal_s16(acc1, vget_high_s16(inA), vget_high_s16(inB));
+    }
+    acc0 = vaddq_s32(acc0, acc1);
+    int32x2_t acc = vadd_s32(vget_low_s32(acc0), vget_high_s32(acc0));
+    uint32_t total = (uint32_t)sum + (uint32_t)vget_lane_s32(vpadd_s32(acc, acc), 0);
+
+    for (; i < len; i++)
+    {
+        total += (uint32_t)(pA[i] * pB[i]);
+    }
+
+    return (q31_t)total;
+}
+#endif
+
+/**
+  @brief         Q15 dot product added to an accumulator, wrapping like __SMLAD.
+                 NEON accelerated when ARM_MATH_NEON is defined.
+  @param[in]     pA       pointer to first vector
+  @param[in]     pB       pointer to second vector
+  @param[in]     len      number of elements
+  @param[in]     sum      accumulator start value
+  @return        sum + dot(pA, pB)
+ */
+__STATIC_FORCEINLINE q31_t arm_nn_dot_q15(const q15_t *pA, const q15_t *pB, int32_t len, q31_t sum)
+{
+#if defined(ARM_MATH_NEON)
+    return arm_nn_dot_q15_neon(pA, pB, len, sum);
+#else
+    uint32_t total = (uint32_t)sum;
+    for (int32_t i = 0; i < len; i++)
+    {
+        total += (uint32_t)(pA[i] * pB[i]);
+    }
+    return (q31_t)total;
+#endif
+}
+
+/**
+  @brief         s8 dot product, NEON accelerated when ARM_MATH_NEON is defined.
+  @param[in]     lhs      pointer to first vector
+  @param[in]     rhs      pointer to second vector
+  @param[in]     len      number of elements
+  @return        sum of lhs[i] * rhs[i]
+ */
+__STATIC_FORCEINLINE int32_t arm_nn_dot_s8(const q7_t *lhs, const q7_t *rhs, int32_t len)
+{
+    int32_t sum = 0;
+    int32_t i = 0;
+
+#if defined(ARM_MATH_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+
+    for (; i + 16 <= len; i += 16)
+    {
+        int8x16_t inA = vld1q_s8(lhs + i);
+        int8x16_t inB = vld1q_s8(rhs + i);
+        acc = vpadalq_s16(acc, vmull_s8(vget_low_s8(inA), vget_low_s8(inB)));
+        acc = vpadalq_s16(acc, vmull_s8(vget_high_s8(inA), vget_high_s8(inB)));
+    }
+    for (; i + 8 <= len; i += 8)
+    {
+        acc = vpadalq_s16(acc, vmull_s8(vld1_s8(lhs + i), vld1_s8(rhs + i)));
+    }
+    int32x2_t acc2 = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+    sum = vget_lane_s32(vpadd_s32(acc2, acc2), 0);
+#endif
+
+    for (; i < len; i++)
+    {
+        sum += lhs[i] * rhs[i];
+    }
+
+    return sum;
+}
+
+/**
+  @brief         Sum of an s8 vector, used to fold the input offset out of the dot product.
+  @param[in]     src      pointer to vector
+  @param[in]     len      number of elements
+  @return        sum of src[i]
+ */
+__STATIC_FORCEINLINE int32_t arm_nn_sum_s8(const q7_t *src, int32_t len)
+{
+    int32_t sum = 0;
+    int32_t i = 0;
+
+#if defined(ARM_MATH_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+
+    for (; i + 16 <= len; i += 16)
+    {
+        acc = vpadalq_s16(acc, vpaddlq_s8(vld1q_s8(src + i)));
+    }
+    int32x2_t acc2 = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+    sum = vget_lane_s32(vpadd_s32(acc2, acc2), 0);
+#endif
+
+    for (; i < len; i++)
+    {
+        sum += src[i];
+    }
+
+    return sum;
+}
+
 /**
   @brief         Read 4 q7 values.
   @param[in]     in_q7       pointer to address of input.
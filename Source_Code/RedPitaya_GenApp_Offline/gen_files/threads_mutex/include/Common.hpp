@@ -12,6 +12,7 @@
 #include <queue>
 #include <deque>
 #include <chrono>
+#include <cmath>
 #include <atomic>
 #include <memory>
 #include <string>
@@ -21,6 +22,7 @@
 
 #include "rp.h"
 #include "../model/include/model.h"
+#include "ModelContext.hpp"
 
 #define DATA_SIZE 16384
 #define QUEUE_MAX_SIZE 1000000
@@ -85,6 +87,7 @@ struct Channel
     std::atomic<uint64_t> end_time_ns{0};
 
     rp_channel_t channel_id;
+    ModelContext *model_ctx = nullptr;
 };
 
 extern std::atomic<bool> stop_acquisition;
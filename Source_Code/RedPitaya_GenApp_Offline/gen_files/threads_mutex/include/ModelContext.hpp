@@ -0,0 +1,25 @@
+/*ModelContext.hpp*/
+
+#pragma once
+
+#include "../model/include/model.h"
+
+#ifndef MODEL_CONTEXTS
+#define MODEL_CONTEXTS 2
+#endif
+
+/*
+ * One independent instance of the generated network. The Makefile builds
+ * model/model.c once per context with cnn renamed to cnn_ctx<N>, so every
+ * context owns the static activation buffers of its own copy and contexts can
+ * run concurrently without touching model.c. The CMSIS-NN kernels model.c
+ * #includes are compiled once and shared (ARM_NN_KERNELS_EXTERNAL).
+ */
+struct ModelContext
+{
+    int id;
+    void (*run)(const input_t input, output_t output);
+};
+
+/* Hands out the next unused context; exits when all MODEL_CONTEXTS are taken. */
+ModelContext *acquire_model_context();
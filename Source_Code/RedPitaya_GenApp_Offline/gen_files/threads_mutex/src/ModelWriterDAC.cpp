@@ -1,6 +1,7 @@
 /*ModelWriterDAC.cpp*/
 
 #include "ModelWriterDAC.hpp"
+#include <algorithm>
 #include <iostream>
 #include <mutex>
 #include <type_traits>
@@ -0,0 +1,80 @@
+/*ContextsTest.cpp*/
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#define STUB_INPUT_DIM 128
+#define STUB_OUTPUT_DIM 2
+#define TEST_WINDOWS 256
+#define TEST_ROUNDS 200
+
+typedef int16_t stub_input_t[STUB_INPUT_DIM][1];
+typedef int16_t stub_output_t[STUB_OUTPUT_DIM];
+
+/* Two copies of test/model_stub.c, built with the same per-context rule as model/model.c. */
+extern "C"
+{
+    void cnn_ctx0(const stub_input_t input, stub_output_t output);
+    void cnn_ctx1(const stub_input_t input, stub_output_t output);
+}
+
+/* Runs every window TEST_ROUNDS times on one context and counts results that differ from the reference. */
+static size_t run_context(void (*cnn)(const stub_input_t, stub_output_t), const stub_input_t *windows,
+                          const stub_output_t *reference)
+{
+    size_t mismatches = 0;
+    for (int round = 0; round < TEST_ROUNDS; ++round)
+    {
+        for (int w = 0; w < TEST_WINDOWS; ++w)
+        {
+            stub_output_t output;
+            cnn(windows[w], output);
+            for (int k = 0; k < STUB_OUTPUT_DIM; ++k)
+                mismatches += output[k] != reference[w][k];
+        }
+    }
+    return mismatches;
+}
+
+static stub_input_t windows0[TEST_WINDOWS], windows1[TEST_WINDOWS];
+static stub_output_t reference0[TEST_WINDOWS], reference1[TEST_WINDOWS];
+
+int main()
+{
+    /* Different inputs per context: shared activation buffers would mix them up. */
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> code(-8192, 8191);
+    for (int w = 0; w < TEST_WINDOWS; ++w)
+    {
+        for (int i = 0; i < STUB_INPUT_DIM; ++i)
+        {
+            windows0[w][i][0] = static_cast<int16_t>(code(rng));
+            windows1[w][i][0] = static_cast<int16_t>(-windows0[w][i][0]);
+        }
+    }
+
+    /* Sequential reference, and both contexts must agree on the same window. */
+    size_t disagreements = 0;
+    for (int w = 0; w < TEST_WINDOWS; ++w)
+    {
+        stub_output_t check;
+        cnn_ctx0(windows0[w], reference0[w]);
+        cnn_ctx1(windows1[w], reference1[w]);
+        cnn_ctx1(windows0[w], check);
+        for (int k = 0; k < STUB_OUTPUT_DIM; ++k)
+            disagreements += check[k] != reference0[w][k];
+    }
+
+    size_t mismatches0 = 0, mismatches1 = 0;
+    std::thread worker0([&] { mismatches0 = run_context(cnn_ctx0, windows0, reference0); });
+    std::thread worker1([&] { mismatches1 = run_context(cnn_ctx1, windows1, reference1); });
+    worker0.join();
+    worker1.join();
+
+    std::cout << "Contexts disagreeing on the same window: " << disagreements << "\n";
+    std::cout << "Concurrent mismatches ctx0 / ctx1: " << mismatches0 << " / " << mismatches1 << " in "
+              << TEST_WINDOWS * TEST_ROUNDS * STUB_OUTPUT_DIM << "\n";
+    return disagreements == 0 && mismatches0 == 0 && mismatches1 == 0 ? 0 : 1;
+}
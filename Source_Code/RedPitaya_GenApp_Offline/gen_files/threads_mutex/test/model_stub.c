@@ -0,0 +1,30 @@
+/*model_stub.c*/
+
+/*
+ * Stand-in for a generated model/model.c: it #includes the bundled kernel
+ * sources the same way and keeps its activations in static buffers, so
+ * test_contexts can link MODEL_CONTEXTS copies of it like the real model.
+ */
+
+#include <string.h>
+
+#include "arm_relu_q15.c"
+#include "arm_fully_connected_q15.c"
+
+#define STUB_INPUT_DIM 128
+#define STUB_OUTPUT_DIM 2
+
+static q15_t activations[STUB_INPUT_DIM];
+static q15_t fc_weights[STUB_OUTPUT_DIM * STUB_INPUT_DIM];
+static const q15_t fc_bias[STUB_OUTPUT_DIM] = {64, -64};
+
+void cnn(const q15_t input[STUB_INPUT_DIM][1], q15_t output[STUB_OUTPUT_DIM])
+{
+    for (int i = 0; i < STUB_OUTPUT_DIM * STUB_INPUT_DIM; i++)
+        fc_weights[i] = (q15_t)(((i * 37) % 255) - 127);
+
+    for (int i = 0; i < STUB_INPUT_DIM; i++)
+        activations[i] = input[i][0];
+    arm_relu_q15(activations, STUB_INPUT_DIM);
+    arm_fully_connected_q15(activations, fc_weights, STUB_INPUT_DIM, STUB_OUTPUT_DIM, 0, 7, fc_bias, output, NULL);
+}
@@ -31,6 +31,9 @@
 #include "arm_nnfunctions.h"
 #include "arm_nnsupportfunctions.h"
 
+/* Built once as its own object; model.c #includes this file and skips it with -DARM_NN_KERNELS_EXTERNAL */
+#ifndef ARM_NN_KERNELS_EXTERNAL
+
 /**
  *  @ingroup groupNN
  */
@@ -62,7 +65,7 @@
  *
  */
 
-arm_status arm_fully_connected_q15(const q15_t *pV,
+arm_status (arm_fully_connected_q15)(const q15_t *pV,
                                    const q15_t *pM,
                                    const uint16_t dim_vec,
                                    const uint16_t num_of_rows,
@@ -73,7 +76,20 @@ arm_status arm_fully_connected_q15(const q15_t *pV,
                                    q15_t *vec_buffer)
 {
     (void)vec_buffer;
-#if defined(ARM_MATH_DSP) && !defined(ARM_MATH_MVEI)
+#if defined(ARM_MATH_NEON)
+    /* Run the following code for Cortex-A cores with NEON */
+    int i;
+    const q15_t *pB = pM;
+
+    for (i = 0; i < num_of_rows; i++)
+    {
+        q31_t sum = ((q31_t)(bias[i]) << bias_shift) + NN_ROUND(out_shift);
+        sum = arm_nn_dot_q15_neon(pV, pB, dim_vec, sum);
+        pOut[i] = (q15_t)__SSAT((sum >> out_shift), 16);
+        pB += dim_vec;
+    }
+
+#elif defined(ARM_MATH_DSP) && !defined(ARM_MATH_MVEI)
     /* Run the following code for Cortex-M4 and Cortex-M7 */
 
     const q15_t *pB = pM;
@@ -190,6 +206,36 @@ arm_status arm_fully_connected_q15(const q15_t *pV,
     return (ARM_MATH_SUCCESS);
 }
 
+arm_status (arm_fully_connected_q15_batch)(const q15_t *pV,
+                                         const q15_t *pM,
+                                         const uint16_t dim_vec,
+                                         const uint16_t num_of_rows,
+                                         const uint16_t bias_shift,
+                                         const uint16_t out_shift,
+                                         const q15_t *bias,
+                                         q15_t *pOut,
+                                         const uint16_t batch)
+{
+    const q15_t *pB = pM;
+
+    for (int i = 0; i < num_of_rows; i++)
+    {
+        const q31_t init = ((q31_t)(bias[i]) << bias_shift) + NN_ROUND(out_shift);
+
+        for (int b = 0; b < batch; b++)
+        {
+            q31_t sum = arm_nn_dot_q15(pV + b * dim_vec, pB, dim_vec, init);
+            pOut[b * num_of_rows + i] = (q15_t)__SSAT((sum >> out_shift), 16);
+        }
+        pB += dim_vec;
+    }
+
+    /* Return to application */
+    return (ARM_MATH_SUCCESS);
+}
+
 /**
  * @} end of FC group
  */
+
+#endif /* ARM_NN_KERNELS_EXTERNAL */
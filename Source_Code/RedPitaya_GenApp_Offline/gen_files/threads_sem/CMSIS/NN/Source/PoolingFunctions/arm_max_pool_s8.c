@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2010-2022 Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_max_pool_s8.c
+ * Description:  Pooling function implementations
+ *
+ * $Date:        17 October 2026
+ * $Revision:    V.1.0.0
+ *
+ * Target Processor:  Cortex-M and Cortex-A (NEON) cores
+ *
+ * -------------------------------------------------------------------- */
+
+#include "arm_nnfunctions.h"
+#include "arm_nnsupportfunctions.h"
+
+/* Built once as its own object; model.c #includes this file and skips it with -DARM_NN_KERNELS_EXTERNAL */
+#ifndef ARM_NN_KERNELS_EXTERNAL
+
+/**
+ *  @ingroup groupNN
+ */
+
+/**
+ * @addtogroup Pooling
+ * @{
+ */
+
+/*
+ * Optimized s8 max pooling function. Channels are processed 16 at a time with
+ * VMAX when built with ARM_MATH_NEON.
+ *
+ * Refer header file for details.
+ *
+ */
+
+arm_status (arm_max_pool_s8)(const cmsis_nn_context *ctx,
+                           const cmsis_nn_pool_params *pool_params,
+                           const cmsis_nn_dims *input_dims,
+                           const q7_t *src,
+                           const cmsis_nn_dims *filter_dims,
+                           const cmsis_nn_dims *output_dims,
+                           q7_t *dst)
+{
+    (void)ctx;
+
+    const int32_t input_y = input_dims->h;
+    const int32_t input_x = input_dims->w;
+    const int32_t output_y = output_dims->h;
+    const int32_t output_x = output_dims->w;
+    const int32_t stride_y = pool_params->stride.h;
+    const int32_t stride_x = pool_params->stride.w;
+    const int32_t kernel_y = filter_dims->h;
+    const int32_t kernel_x = filter_dims->w;
+    const int32_t pad_y = pool_params->padding.h;
+    const int32_t pad_x = pool_params->padding.w;
+    const int32_t act_min = pool_params->activation.min;
+    const int32_t act_max = pool_params->activation.max;
+    const int32_t channel_in = input_dims->c;
+
+    for (int32_t i_y = 0, base_idx_y = -pad_y; i_y < output_y; base_idx_y += stride_y, i_y++)
+    {
+        const int32_t ker_y_start = MAX(0, -base_idx_y);
+        const int32_t ker_y_end = MIN(kernel_y, input_y - base_idx_y);
+
+        for (int32_t i_x = 0, base_idx_x = -pad_x; i_x < output_x; base_idx_x += stride_x, i_x++)
+        {
+            const int32_t ker_x_start = MAX(0, -base_idx_x);
+            const int32_t ker_x_end = MIN(kernel_x, input_x - base_idx_x);
+            int32_t i_ch = 0;
+
+#if defined(ARM_MATH_NEON)
+            const int8x16_t vmin = vdupq_n_s8((int8_t)MAX(act_min, NN_Q7_MIN));
+            const int8x16_t vmax = vdupq_n_s8((int8_t)MIN(act_max, NN_Q7_MAX));
+
+            for (; i_ch + 16 <= channel_in; i_ch += 16)
+            {
+                int8x16_t max = vdupq_n_s8(NN_Q7_MIN);
+                for (int32_t k_y = ker_y_start; k_y < ker_y_end; k_y++)
+                {
+                    for (int32_t k_x = ker_x_start; k_x < ker_x_end; k_x++)
+                    {
+                        const q7_t *start = src + i_ch + channel_in * (k_x + base_idx_x + (k_y + base_idx_y) * input_x);
+                        max = vmaxq_s8(max, vld1q_s8(start));
+                    }
+                }
+                max = vminq_s8(vmaxq_s8(max, vmin), vmax);
+                vst1q_s8(dst + i_ch, max);
+            }
+#endif
+
+            for (; i_ch < channel_in; i_ch++)
+            {
+                int32_t max = NN_Q7_MIN;
+                for (int32_t k_y = ker_y_start; k_y < ker_y_end; k_y++)
+                {
+                    for (int32_t k_x = ker_x_start; k_x < ker_x_end; k_x++)
+                    {
+                        const q7_t *start = src + i_ch + channel_in * (k_x + base_idx_x + (k_y + base_idx_y) * input_x);
+                        if (*start > max)
+                        {
+                            max = *start;
+                        }
+                    }
+                }
+                max = MAX(max, act_min);
+                max = MIN(max, act_max);
+                dst[i_ch] = (q7_t)max;
+            }
+            dst += channel_in;
+        }
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of Pooling group
+ */
+
+#endif /* ARM_NN_KERNELS_EXTERNAL */
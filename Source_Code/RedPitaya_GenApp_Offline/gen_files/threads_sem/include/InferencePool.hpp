@@ -0,0 +1,28 @@
+/*InferencePool.hpp*/
+
+#pragma once
+
+#include "Common.hpp"
+
+#ifndef INFERENCE_POOL
+#define INFERENCE_POOL 1
+#endif
+
+#ifndef INFERENCE_POOL_WORKERS
+#define INFERENCE_POOL_WORKERS MODEL_CONTEXTS
+#endif
+
+/*
+ * Shared inference pool for both channels. Every worker owns a model context and a deque; a
+ * channel's windows go to its home worker, and a worker whose deque is empty steals the oldest
+ * window of another one, so a single busy channel can keep every core busy. Each window carries
+ * its channel's sequence number and results are released to the CSV/DAC sinks in that order.
+ */
+void inference_pool_start();
+void inference_pool_submit(Channel &channel, const std::shared_ptr<data_part_t> &part);
+void inference_pool_close(Channel &channel);
+void inference_pool_wake();
+void inference_pool_join();
+int inference_pool_run_count(int worker);
+int inference_pool_peak_running();
+void print_inference_pool_stats();
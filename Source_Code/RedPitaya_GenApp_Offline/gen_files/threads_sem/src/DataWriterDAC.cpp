@@ -1,6 +1,7 @@
 /* DataWriter.cpp */
 
 #include "DataWriterDAC.hpp"
+#include <algorithm>
 #include <iostream>
 #include <type_traits>
 
@@ -8,34 +9,34 @@ void write_data_dac(Channel &channel, rp_channel_t rp_channel)
 {
     try
     {
+        const data_part_t *part = nullptr;
+
         while (true)
         {
-            if (sem_wait(&channel.data_sem_dac) != 0)
+            if (!channel.data_ring_dac.wait(&channel.data_sem_dac))
             {
-                if (errno == EINTR && stop_program.load())
+                if (stop_program.load())
                     break;
                 continue;
             }
 
-            if (stop_program.load() && channel.data_queue_dac.empty())
+            if (stop_program.load() && channel.data_ring_dac.empty())
                 break;
 
-            while (!channel.data_queue_dac.empty())
+            while ((part = channel.data_ring_dac.peek()) != nullptr)
             {
-                std::shared_ptr<data_part_t> part = channel.data_queue_dac.front();
-                channel.data_queue_dac.pop();
-
                 for (size_t k = 0; k < MODEL_INPUT_DIM_0; k++)
                 {
                     float voltage = OutputToVoltage(part->data[k][0]);
                     voltage = std::clamp(voltage, -1.0f, 1.0f);
                     rp_GenAmp(rp_channel, voltage);
                 }
+                channel.data_ring_dac.consume();
 
                 channel.write_count_dac.fetch_add(1, std::memory_order_relaxed);
             }
 
-            if (channel.acquisition_done && channel.data_queue_dac.empty())
+            if (channel.acquisition_done.load() && channel.data_ring_dac.empty())
                 break;
         }
 
@@ -0,0 +1,224 @@
+/*InferencePool.cpp*/
+
+#include "InferencePool.hpp"
+#include "SystemUtils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+static_assert(INFERENCE_POOL_WORKERS >= 1 && INFERENCE_POOL_WORKERS <= MODEL_CONTEXTS,
+              "INFERENCE_POOL_WORKERS needs one model context per worker");
+
+extern bool save_output_csv;
+extern bool save_output_dac;
+
+struct pool_task_t
+{
+    Channel *channel;
+    uint64_t seq;
+    std::shared_ptr<data_part_t> part;
+};
+
+struct pool_worker_t
+{
+    std::mutex lock;
+    std::deque<pool_task_t> tasks;
+    ModelContext *model_ctx = nullptr;
+    std::atomic<int> run_count{0};
+    std::atomic<int> steal_count{0};
+};
+
+static pool_worker_t workers[INFERENCE_POOL_WORKERS];
+static std::vector<std::thread> worker_threads;
+static Channel *const pool_channels[] = {&channel1, &channel2};
+static constexpr int pool_channel_count = sizeof(pool_channels) / sizeof(pool_channels[0]);
+
+/* One post per queued window plus INFERENCE_POOL_WORKERS wake-ups per closed channel. */
+static sem_t pool_sem;
+static std::atomic<int> closed_channels{0};
+
+/* Workers inside cnn() right now, and the most seen at once. */
+static std::atomic<int> running_workers{0};
+static std::atomic<int> peak_running{0};
+
+static int home_worker(const Channel &channel)
+{
+    for (int i = 0; i < pool_channel_count; ++i)
+    {
+        if (pool_channels[i] == &channel)
+            return i % INFERENCE_POOL_WORKERS;
+    }
+    return 0;
+}
+
+/* Own deque first, then the others; the thief also takes the oldest window to keep the reorder window short. */
+static bool take_task(int self, pool_task_t &task)
+{
+    for (int i = 0; i < INFERENCE_POOL_WORKERS; ++i)
+    {
+        pool_worker_t &victim = workers[(self + i) % INFERENCE_POOL_WORKERS];
+        std::lock_guard<std::mutex> lock(victim.lock);
+        if (victim.tasks.empty())
+            continue;
+
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        if (i != 0)
+            workers[self].steal_count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Results may finish out of order across workers; hold them until every earlier window of the channel is out.
+ * reorder_mutex also serialises the workers pushing into the channel's result rings.
+ */
+static void release_result(Channel &channel, uint64_t seq, const model_result_t &result)
+{
+    std::lock_guard<std::mutex> lock(channel.reorder_mutex);
+    channel.reorder_pending.emplace(seq, result);
+
+    auto it = channel.reorder_pending.begin();
+    while (it != channel.reorder_pending.end() && it->first == channel.reorder_next)
+    {
+        publish_result(channel, it->second);
+        it = channel.reorder_pending.erase(it);
+        channel.reorder_next++;
+    }
+}
+
+static void pool_worker(int self)
+{
+    try
+    {
+        pool_worker_t &worker = workers[self];
+        pool_task_t task;
+
+        while (true)
+        {
+            if (sem_wait(&pool_sem) != 0 && errno != EINTR)
+                continue;
+
+            if (!take_task(self, task))
+            {
+                if (closed_channels.load() == pool_channel_count || stop_program.load())
+                    break;
+                continue;
+            }
+
+            int running = running_workers.fetch_add(1, std::memory_order_relaxed) + 1;
+            int peak = peak_running.load(std::memory_order_relaxed);
+            while (running > peak && !peak_running.compare_exchange_weak(peak, running, std::memory_order_relaxed))
+            {
+            }
+
+            model_result_t result;
+            auto start = std::chrono::high_resolution_clock::now();
+            worker.model_ctx->run(task.part->data, result.output);
+            auto end = std::chrono::high_resolution_clock::now();
+            running_workers.fetch_sub(1, std::memory_order_relaxed);
+            result.computation_time = std::chrono::duration<double, std::milli>(end - start).count();
+
+            release_result(*task.channel, task.seq, result);
+            worker.run_count.fetch_add(1, std::memory_order_relaxed);
+            task.part.reset();
+        }
+
+        std::cout << "Inference pool worker " << self << " exiting..." << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Exception in inference pool worker " << self << ": " << e.what() << std::endl;
+    }
+}
+
+void inference_pool_start()
+{
+    sem_init(&pool_sem, 0, 0);
+
+    unsigned int cores = std::thread::hardware_concurrency();
+    if (cores == 0)
+        cores = 1;
+
+    for (int i = 0; i < INFERENCE_POOL_WORKERS; ++i)
+        workers[i].model_ctx = acquire_model_context();
+
+    for (int i = 0; i < INFERENCE_POOL_WORKERS; ++i)
+    {
+        worker_threads.emplace_back(pool_worker, i);
+        set_thread_priority(worker_threads.back(), model_priority);
+        if (!set_thread_affinity(worker_threads.back(), i % cores))
+            std::cerr << "Failed to pin inference pool worker " << i << " to core " << i % cores << std::endl;
+    }
+}
+
+/* Called from the channel's acquisition thread only, so the sequence counter needs no lock. */
+void inference_pool_submit(Channel &channel, const std::shared_ptr<data_part_t> &part)
+{
+    pool_worker_t &worker = workers[home_worker(channel)];
+    {
+        std::lock_guard<std::mutex> lock(worker.lock);
+        worker.tasks.push_back({&channel, channel.window_seq++, part});
+    }
+    sem_post(&pool_sem);
+}
+
+void inference_pool_close(Channel &channel)
+{
+    (void)channel;
+    closed_channels.fetch_add(1);
+    for (int i = 0; i < INFERENCE_POOL_WORKERS; ++i)
+        sem_post(&pool_sem);
+}
+
+/* Async-signal-safe: only posts the semaphore so blocked workers re-check stop_program. */
+void inference_pool_wake()
+{
+    for (int i = 0; i < INFERENCE_POOL_WORKERS; ++i)
+        sem_post(&pool_sem);
+}
+
+void inference_pool_join()
+{
+    for (auto &th : worker_threads)
+    {
+        if (th.joinable())
+            th.join();
+    }
+
+    for (Channel *channel : pool_channels)
+    {
+        channel->processing_done.store(true);
+        if (save_output_csv)
+            sem_post(&channel->result_sem_csv);
+        if (save_output_dac)
+            sem_post(&channel->result_sem_dac);
+    }
+
+    sem_destroy(&pool_sem);
+}
+
+int inference_pool_run_count(int worker)
+{
+    return workers[worker].run_count.load();
+}
+
+int inference_pool_peak_running()
+{
+    return peak_running.load();
+}
+
+void print_inference_pool_stats()
+{
+    std::cout << "====================================\n\n";
+    for (int i = 0; i < INFERENCE_POOL_WORKERS; ++i)
+    {
+        std::string label = "Inference pool worker " + std::to_string(i) + " on context " +
+                            std::to_string(workers[i].model_ctx ? workers[i].model_ctx->id : -1) + " (windows / stolen):";
+        std::cout << std::left << std::setw(60) << label
+                  << workers[i].run_count.load() << " / " << workers[i].steal_count.load() << '\n';
+    }
+    std::cout << std::left << std::setw(60) << "Inference pool peak concurrent windows:" << inference_pool_peak_running() << '\n';
+    std::cout << "\n====================================\n";
+}
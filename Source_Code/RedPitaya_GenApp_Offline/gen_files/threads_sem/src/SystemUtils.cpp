@@ -1,6 +1,7 @@
 /*SystemUtils.cpp*/
 
 #include "SystemUtils.hpp"
+#include "InferencePool.hpp"
 #include <iostream>
 #include <csignal>
 #include <iomanip>
@@ -70,6 +71,10 @@ void signal_handler(int sig)
         sem_post(&channel2.model_sem);
         sem_post(&channel2.result_sem_csv);
         sem_post(&channel2.result_sem_dac);
+
+#if INFERENCE_POOL
+        inference_pool_wake();
+#endif
     }
 }
 
@@ -106,19 +111,26 @@ void print_channel_stats(const Channel &channel)
     if (save_data_csv)
     {
         std::cout << std::left << std::setw(60) << "Total lines written to csv file:" << channel.write_count_csv.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Windows dropped on full CSV data ring:" << channel.data_drop_csv.load() << '\n';
     }
     if (save_data_dac)
     {
         std::cout << std::left << std::setw(60) << "Total lines written to dac:" << channel.write_count_csv.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Windows dropped on full DAC data ring:" << channel.data_drop_dac.load() << '\n';
     }
     std::cout << std::left << std::setw(60) << "Total model calculated:" << channel.model_count.load() << '\n';
+#if !INFERENCE_POOL
+    std::cout << std::left << std::setw(60) << "Windows dropped on full model ring:" << channel.model_drop.load() << '\n';
+#endif
     if (save_output_csv)
     {
         std::cout << std::left << std::setw(60) << "Total results logged to CSV file:" << channel.log_count_csv.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Results dropped on full CSV result ring:" << channel.result_drop_csv.load() << '\n';
     }
     if (save_output_dac)
     {
         std::cout << std::left << std::setw(60) << "Total results written to DAC:" << channel.log_count_dac.load() << '\n';
+        std::cout << std::left << std::setw(60) << "Results dropped on full DAC result ring:" << channel.result_drop_dac.load() << '\n';
     }
 
     std::cout << "\n====================================\n";
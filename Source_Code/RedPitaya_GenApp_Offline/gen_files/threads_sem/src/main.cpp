@@ -28,6 +28,7 @@
 #include "DataWriterCSV.hpp"
 #include "DataWriterDAC.hpp"
 #include "ModelProcessing.hpp"
+#include "InferencePool.hpp"
 #include "ModelWriterCSV.hpp"
 #include "ModelWriterDAC.hpp"
 #include "DAC.hpp"
@@ -76,27 +77,44 @@ int main()
 
     initialize_acq();
     initialize_DAC();
+
+#if INFERENCE_POOL
+    inference_pool_start();
+#else
+    channel1.model_ctx = acquire_model_context();
+    channel2.model_ctx = acquire_model_context();
+#endif
     std::thread acq_thread1(acquire_data, std::ref(channel1), RP_CH_1);
     std::thread acq_thread2(acquire_data, std::ref(channel2), RP_CH_2);
+#if !INFERENCE_POOL
     std::thread model_thread1(model_inference, std::ref(channel1));
     std::thread model_thread2(model_inference, std::ref(channel2));
+#endif
 
     std::thread write_thread_csv1, write_thread_dac1, log_thread_csv1, log_thread_dac1;
     std::thread write_thread_csv2, write_thread_dac2, log_thread_csv2, log_thread_dac2;
 
     if (save_data_csv)
+    {
         write_thread_csv1 = std::thread(write_data_csv, std::ref(channel1), "DataOutput/data_ch1.csv");
-    write_thread_csv2 = std::thread(write_data_csv, std::ref(channel2), "DataOutput/data_ch2.csv");
+        write_thread_csv2 = std::thread(write_data_csv, std::ref(channel2), "DataOutput/data_ch2.csv");
+    }
     if (save_data_dac)
+    {
         write_thread_dac1 = std::thread(write_data_dac, std::ref(channel1), RP_CH_1);
-    write_thread_dac2 = std::thread(write_data_dac, std::ref(channel2), RP_CH_2);
+        write_thread_dac2 = std::thread(write_data_dac, std::ref(channel2), RP_CH_2);
+    }
 
     if (save_output_csv)
+    {
         log_thread_csv1 = std::thread(log_results_csv, std::ref(channel1), "ModelOutput/output_ch1.csv");
-    log_thread_csv2 = std::thread(log_results_csv, std::ref(channel2), "ModelOutput/output_ch2.csv");
+        log_thread_csv2 = std::thread(log_results_csv, std::ref(channel2), "ModelOutput/output_ch2.csv");
+    }
     if (save_output_dac)
+    {
         log_thread_dac1 = std::thread(log_results_dac, std::ref(channel1), RP_CH_1);
-    log_thread_dac2 = std::thread(log_results_dac, std::ref(channel2), RP_CH_2);
+        log_thread_dac2 = std::thread(log_results_dac, std::ref(channel2), RP_CH_2);
+    }
 
     
     
@@ -104,8 +122,10 @@ int main()
     
     
     
+#if !INFERENCE_POOL
     set_thread_priority(model_thread1, model_priority);
     set_thread_priority(model_thread2, model_priority);
+#endif
     
     
     
@@ -115,10 +135,14 @@ int main()
         acq_thread1.join();
     if (acq_thread2.joinable())
         acq_thread2.join();
+#if INFERENCE_POOL
+    inference_pool_join();
+#else
     if (model_thread1.joinable())
         model_thread1.join();
     if (model_thread2.joinable())
         model_thread2.join();
+#endif
     if (save_data_csv && write_thread_csv1.joinable())
         write_thread_csv1.join();
     if (save_data_csv && write_thread_csv2.joinable())
@@ -139,6 +163,9 @@ int main()
     cleanup();
     print_channel_stats(channel1);
     print_channel_stats(channel2);
+#if INFERENCE_POOL
+    print_inference_pool_stats();
+#endif
 
     sem_destroy(&channel1.data_sem_csv);
     sem_destroy(&channel1.data_sem_dac);
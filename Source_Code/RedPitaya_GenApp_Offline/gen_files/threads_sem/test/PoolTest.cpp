@@ -0,0 +1,121 @@
+/*PoolTest.cpp*/
+
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "InferencePool.hpp"
+
+#define TEST_WINDOWS 4000
+
+/* Defined by main.cpp in the application. */
+bool save_data_csv = false;
+bool save_data_dac = false;
+bool save_output_csv = true;
+bool save_output_dac = false;
+
+extern "C" void cnn_ctx0(const input_t input, output_t output);
+
+/* Drains a channel's CSV result ring while the pool fills it, the way log_results_csv does. */
+static void consume_results(Channel &channel, std::vector<model_result_t> &results)
+{
+    const model_result_t *result = nullptr;
+    while (true)
+    {
+        channel.result_ring_csv.wait(&channel.result_sem_csv);
+        while ((result = channel.result_ring_csv.peek()) != nullptr)
+        {
+            results.push_back(*result);
+            channel.result_ring_csv.consume();
+        }
+        if (channel.processing_done.load() && channel.result_ring_csv.empty())
+            break;
+    }
+}
+
+/*
+ * Feeds random windows of both channels through the inference pool and checks
+ * that every channel gets its results in order and equal to running the same
+ * windows one by one on a single context, which is what each channel's model
+ * thread does with INFERENCE_POOL=0. Channel 1 gets most windows so the other
+ * worker has to steal. Results are consumed while the workers release them.
+ * Fails unless every worker ran windows and, on a multi-core CPU, at least two
+ * ran at the same time.
+ */
+int main()
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> code(-8192, 8191);
+
+    std::vector<std::shared_ptr<data_part_t>> windows[2];
+    std::vector<model_result_t> reference[2];
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        int count = ch == 0 ? TEST_WINDOWS : TEST_WINDOWS / 4;
+        for (int w = 0; w < count; ++w)
+        {
+            auto part = std::make_shared<data_part_t>();
+            std::vector<int16_t> raw(MODEL_INPUT_DIM_0);
+            for (int16_t &sample : raw)
+                sample = static_cast<int16_t>(code(rng));
+            convert_raw_data(raw.data(), part->data, MODEL_INPUT_DIM_0);
+
+            model_result_t result;
+            cnn_ctx0(part->data, result.output);
+            windows[ch].push_back(part);
+            reference[ch].push_back(result);
+        }
+    }
+
+    Channel *channels[2] = {&channel1, &channel2};
+    for (Channel *channel : channels)
+    {
+        sem_init(&channel->result_sem_csv, 0, 0);
+        sem_init(&channel->result_sem_dac, 0, 0);
+    }
+
+    std::vector<model_result_t> results[2];
+    std::thread consumers[2];
+    for (int ch = 0; ch < 2; ++ch)
+        consumers[ch] = std::thread(consume_results, std::ref(*channels[ch]), std::ref(results[ch]));
+
+    inference_pool_start();
+    for (int w = 0; w < TEST_WINDOWS; ++w)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            if (w < static_cast<int>(windows[ch].size()))
+                inference_pool_submit(*channels[ch], windows[ch][w]);
+        }
+    }
+    inference_pool_close(channel1);
+    inference_pool_close(channel2);
+    inference_pool_join();
+    for (std::thread &consumer : consumers)
+        consumer.join();
+
+    bool ok = true;
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        size_t mismatches = results[ch].size() == reference[ch].size() ? 0 : reference[ch].size();
+        for (size_t w = 0; w < results[ch].size() && w < reference[ch].size(); ++w)
+        {
+            for (size_t k = 0; k < std::size(results[ch][w].output); ++k)
+                mismatches += results[ch][w].output[k] != reference[ch][w].output[k];
+        }
+        std::cout << "CH" << ch + 1 << ": " << results[ch].size() << " results, " << mismatches
+                  << " differing from the single-context run\n";
+        ok = ok && mismatches == 0;
+    }
+
+    print_inference_pool_stats();
+    for (int i = 0; i < INFERENCE_POOL_WORKERS; ++i)
+        ok = ok && inference_pool_run_count(i) > 0;
+    /* Workers are pinned to core i % cores, so they can only overlap on a multi-core CPU. */
+    if (INFERENCE_POOL_WORKERS >= 2 && std::thread::hardware_concurrency() >= 2)
+        ok = ok && inference_pool_peak_running() >= 2;
+
+    std::cout << (ok ? "OK" : "FAIL") << ": inference pool with " << INFERENCE_POOL_WORKERS << " workers\n";
+    return ok ? 0 : 1;
+}
@@ -6,7 +6,6 @@
 #include <filesystem>
 #include <fstream>
 #include <sstream>
-#include <regex>
 #include <atomic>
 
 class ExportManager
@@ -26,7 +25,4 @@ public:
                                                const std::string &privateKeyPath,
                                                const std::string &targetDirectory,
                                                const std::atomic<bool> &cancelExportFlag);
-
-private:
-    static void removeStaticFromModelC(const std::string &versionPath);
 };
@@ -5,27 +5,6 @@
 
 namespace fs = std::filesystem;
 
-void ExportManager::removeStaticFromModelC(const std::string &versionPath)
-{
-    fs::path modelCPath = fs::path(versionPath) / "model.c";
-    if (!fs::exists(modelCPath))
-        return;
-
-    std::ifstream in(modelCPath);
-    std::stringstream buffer;
-    buffer << in.rdbuf();
-    in.close();
-
-    std::string content = buffer.str();
-
-    std::regex staticRegex(R"(\bstatic\b\s*)");
-    std::string modified = std::regex_replace(content, staticRegex, "");
-
-    std::ofstream out(modelCPath);
-    out << modified;
-    out.close();
-}
-
 bool ExportManager::exportLocally(const std::string &modelFolder,
                                   const std::string &genFilesDir,
                                   const std::string &version,
@@ -55,9 +34,6 @@ bool ExportManager::exportLocally(const std::string &modelFolder,
         fs::copy(modelFolder, versionDstPath / "model",
                  fs::copy_options::recursive | fs::copy_options::overwrite_existing);
 
-        if ((version == "threads_mutex" || version == "threads_sem") && !cancelExportFlag.load())
-            removeStaticFromModelC((versionDstPath / "model").string());
-
         return !cancelExportFlag.load();
     }
     catch (const std::exception &e)
@@ -94,9 +70,6 @@ bool ExportManager::exportSingleVersionToRedPitaya(const std::string &modelFolde
     fs::copy(modelFolder, tempModelDir,
              fs::copy_options::recursive | fs::copy_options::overwrite_existing);
 
-    if ((version == "threads_mutex" || version == "threads_sem") && !cancelExportFlag.load())
-        removeStaticFromModelC(tempModelDir);
-
     if (cancelExportFlag.load())
         return false;
     if (!SSHManager::scp_transfer(hostname, password, tempModelDir, remoteModelDir, privateKeyPath))
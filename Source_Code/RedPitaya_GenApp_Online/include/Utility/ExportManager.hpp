@@ -33,5 +33,6 @@ public:
                                                const std::atomic<bool> &cancelExportFlag);
 
 private:
+    static bool needsStaticRemoval(const std::string &version, const std::string &codePath);
     static void removeStaticFromModelC(const std::string &versionPath);
 };
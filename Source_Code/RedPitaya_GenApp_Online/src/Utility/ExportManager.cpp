@@ -11,6 +11,15 @@ const std::unordered_map<std::string, std::string> ExportManager::versionGitLink
     {"process_mutex", "https://github.com/aymanehajjaoui/process_mutex.git"},
     {"process_sem", "https://github.com/aymanehajjaoui/process_sem.git"}};
 
+bool ExportManager::needsStaticRemoval(const std::string &version, const std::string &codePath)
+{
+    if (version != "threads_mutex" && version != "threads_sem")
+        return false;
+
+    // Trees with per-channel model contexts build model.c once per thread and need it untouched
+    return !fs::exists(fs::path(codePath) / "include" / "ModelContext.hpp");
+}
+
 void ExportManager::removeStaticFromModelC(const std::string &versionPath)
 {
     fs::path modelCPath = fs::path(versionPath) / "model.c";
@@ -63,7 +72,7 @@ bool ExportManager::exportLocally(const std::string &modelFolder,
             return false;
         fs::copy(modelFolder, versionDstPath / "model", fs::copy_options::recursive | fs::copy_options::overwrite_existing);
 
-        if ((version == "threads_mutex" || version == "threads_sem") && !cancelExportFlag.load())
+        if (needsStaticRemoval(version, versionDstPath.string()) && !cancelExportFlag.load())
             removeStaticFromModelC((versionDstPath / "model").string());
 
         return !cancelExportFlag.load();
@@ -105,12 +114,12 @@ bool ExportManager::exportSingleVersionToRedPitaya(const std::string &modelFolde
             return false;
         fs::copy(modelFolder, tempModelDir, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
 
-        if ((version == "threads_mutex" || version == "threads_sem") && !cancelExportFlag.load())
-            removeStaticFromModelC(tempModelDir);
-
         if (!cloneVersionFromGit(version, tempCodeDir))
             return false;
 
+        if (needsStaticRemoval(version, tempCodeDir) && !cancelExportFlag.load())
+            removeStaticFromModelC(tempModelDir);
+
         if (cancelExportFlag.load())
             return false;
         if (!SSHManager::scp_transfer(hostname, password, tempModelDir, remoteModelDir, privateKeyPath))            return false;